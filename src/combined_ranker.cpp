@@ -3,15 +3,16 @@
 // Date: Summer 2022
 
 #include "combined_ranker.h"
+#include <vector>
 
 CombinedRanker::CombinedRanker() : CombinedRanker("CombinedRanker()") {}
 CombinedRanker::CombinedRanker(std::string_view name) : AbstractRanker(name) {}
-void CombinedRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void CombinedRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
-    letter_ranker.SetUp(eligible_fp, guess, feedback);
-    two_letter_ranker.SetUp(eligible_fp, guess, feedback);
-    three_letter_ranker.SetUp(eligible_fp, guess, feedback);
-    position_ranker.SetUp(eligible_fp, guess, feedback);
+    letter_ranker.SetUp(eligible, guess, feedback);
+    two_letter_ranker.SetUp(eligible, guess, feedback);
+    three_letter_ranker.SetUp(eligible, guess, feedback);
+    position_ranker.SetUp(eligible, guess, feedback);
 }
 
 int CombinedRanker::Rank(std::string_view word) const
@@ -19,6 +20,30 @@ int CombinedRanker::Rank(std::string_view word) const
     return letter_ranker.Rank(word) + two_letter_ranker.Rank(word) + three_letter_ranker.Rank(word) + position_ranker.Rank(word);
 }
 
+void CombinedRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    letter_ranker.RankAll(words, ranks);
+
+    // Add the ranks of the other rankers one batch at a time
+    std::vector<int> partial_ranks(words.size());
+    auto add_ranks{[&words, &ranks, &partial_ranks](const AbstractRanker &r)
+                   {
+                       r.RankAll(words, partial_ranks);
+                       for (size_t i{0}; i < words.size(); i++)
+                       {
+                           ranks[i] += partial_ranks[i];
+                       }
+                   }};
+    add_ranks(two_letter_ranker);
+    add_ranks(three_letter_ranker);
+    add_ranks(position_ranker);
+}
+
+std::unique_ptr<AbstractRanker> CombinedRanker::Clone() const
+{
+    return std::make_unique<CombinedRanker>(*this);
+}
+
 std::string CombinedRanker::GetDebugInfo() const
 {
     return letter_ranker.GetDebugInfo() + "\n" + two_letter_ranker.GetDebugInfo() + "\n" + three_letter_ranker.GetDebugInfo() + "\n" + position_ranker.GetDebugInfo();
@@ -37,15 +37,16 @@ public:
     /*
     Sets up a CombinedRanker to rank based on the currently eligible words.
 
-    Runs SetUp for each of 4 used rankers.
+    Runs SetUp for each of 4 used rankers. They all rank with the same
+    EligibleWords::GetStatistics, so the eligible words are only read once.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes the rank of a word as the weighted sum of the Rank outputs for the 4 used rankers.
@@ -60,6 +61,12 @@ public:
     */
     virtual int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
     // Returns a string of debug info returned by each of used rankers separated by blank lines
     virtual std::string GetDebugInfo() const override;
 
@@ -0,0 +1,282 @@
+// Implementation of FeedbackConstraint
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "constraint.h"
+#include "misc.h"
+
+// SIMD kernels are only built for x86 with GCC or Clang which support per
+// function target attributes and runtime CPU detection
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONSTRAINT_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+class FeedbackConstraint::Private
+{
+public:
+    // Checks the count constraints that could not be reduced to letter masks
+    static bool CountsMatch(const FeedbackConstraint &self, uint32_t code)
+    {
+        for (auto j{0}; j < self.num_counted; j++)
+        {
+            uint8_t count{0};
+            for (auto i{0}; i < WORD_LENGTH; i++)
+            {
+                count += CodeLetter(code, i) == self.counted_letters[j];
+            }
+            if (count < self.min_counts[j] || count > self.max_counts[j])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Writes word i to position kept if it passes the count constraints (the
+    // vector kernels have already checked everything else), returns new kept
+    static size_t Keep(const FeedbackConstraint &self, uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t i, size_t kept)
+    {
+        if (self.num_counted > 0 && !CountsMatch(self, codes[i]))
+        {
+            return kept;
+        }
+        ids[kept] = ids[i];
+        codes[kept] = codes[i];
+        masks[kept] = masks[i];
+        return kept + 1;
+    }
+
+    static size_t FilterScalar(const FeedbackConstraint &self, uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t begin, size_t n, size_t kept)
+    {
+        for (auto i{begin}; i < n; i++)
+        {
+            if (self.Matches(codes[i], masks[i]))
+            {
+                ids[kept] = ids[i];
+                codes[kept] = codes[i];
+                masks[kept] = masks[i];
+                kept++;
+            }
+        }
+        return kept;
+    }
+
+#ifdef CONSTRAINT_X86_KERNELS
+    __attribute__((target("avx2"))) static size_t FilterAvx2(const FeedbackConstraint &self, uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t n)
+    {
+        const auto green_bits{_mm256_set1_epi32(self.green_bits)};
+        const auto green_code{_mm256_set1_epi32(self.green_code)};
+        const auto required{_mm256_set1_epi32(self.required_letters)};
+        const auto forbidden{_mm256_set1_epi32(self.forbidden_letters)};
+        const auto zero{_mm256_setzero_si256()};
+
+        size_t kept{0};
+        size_t i{0};
+        for (; i + 8 <= n; i += 8)
+        {
+            auto c{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(codes + i))};
+            auto m{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(masks + i))};
+
+            // Lanes stay all ones while the word satisfies every check
+            auto ok{_mm256_cmpeq_epi32(_mm256_and_si256(c, green_bits), green_code)};
+            ok = _mm256_and_si256(ok, _mm256_cmpeq_epi32(_mm256_and_si256(m, required), required));
+            ok = _mm256_and_si256(ok, _mm256_cmpeq_epi32(_mm256_and_si256(m, forbidden), zero));
+            for (auto j{0}; j < self.num_excluded; j++)
+            {
+                auto at{_mm256_and_si256(c, _mm256_set1_epi32(self.excluded_bits[j]))};
+                ok = _mm256_andnot_si256(_mm256_cmpeq_epi32(at, _mm256_set1_epi32(self.excluded_code[j])), ok);
+            }
+
+            auto bits{static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(ok)))};
+            while (bits != 0)
+            {
+                kept = Keep(self, ids, codes, masks, i + __builtin_ctz(bits), kept);
+                bits &= bits - 1;
+            }
+        }
+        return FilterScalar(self, ids, codes, masks, i, n, kept);
+    }
+
+    __attribute__((target("sse2"))) static size_t FilterSse2(const FeedbackConstraint &self, uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t n)
+    {
+        const auto green_bits{_mm_set1_epi32(self.green_bits)};
+        const auto green_code{_mm_set1_epi32(self.green_code)};
+        const auto required{_mm_set1_epi32(self.required_letters)};
+        const auto forbidden{_mm_set1_epi32(self.forbidden_letters)};
+        const auto zero{_mm_setzero_si128()};
+
+        size_t kept{0};
+        size_t i{0};
+        for (; i + 4 <= n; i += 4)
+        {
+            auto c{_mm_loadu_si128(reinterpret_cast<const __m128i *>(codes + i))};
+            auto m{_mm_loadu_si128(reinterpret_cast<const __m128i *>(masks + i))};
+
+            auto ok{_mm_cmpeq_epi32(_mm_and_si128(c, green_bits), green_code)};
+            ok = _mm_and_si128(ok, _mm_cmpeq_epi32(_mm_and_si128(m, required), required));
+            ok = _mm_and_si128(ok, _mm_cmpeq_epi32(_mm_and_si128(m, forbidden), zero));
+            for (auto j{0}; j < self.num_excluded; j++)
+            {
+                auto at{_mm_and_si128(c, _mm_set1_epi32(self.excluded_bits[j]))};
+                ok = _mm_andnot_si128(_mm_cmpeq_epi32(at, _mm_set1_epi32(self.excluded_code[j])), ok);
+            }
+
+            auto bits{static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(ok)))};
+            while (bits != 0)
+            {
+                kept = Keep(self, ids, codes, masks, i + __builtin_ctz(bits), kept);
+                bits &= bits - 1;
+            }
+        }
+        return FilterScalar(self, ids, codes, masks, i, n, kept);
+    }
+#endif
+
+    static size_t FilterPortable(const FeedbackConstraint &self, uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t n)
+    {
+        return FilterScalar(self, ids, codes, masks, 0, n, 0);
+    }
+
+    // Type of the filtering kernels above
+    using KernelFunction = size_t (*)(const FeedbackConstraint &, uint32_t *, uint32_t *, uint32_t *, size_t);
+
+    // Gets the function of a kernel, nullptr if it is not supported
+    static KernelFunction GetKernelFunction(Kernel kernel)
+    {
+#ifdef CONSTRAINT_X86_KERNELS
+        __builtin_cpu_init();
+        if (kernel == Kernel::Avx2 && __builtin_cpu_supports("avx2"))
+        {
+            return FilterAvx2;
+        }
+        if (kernel == Kernel::Sse2 && __builtin_cpu_supports("sse2"))
+        {
+            return FilterSse2;
+        }
+#endif
+        return kernel == Kernel::Scalar ? FilterPortable : nullptr;
+    }
+
+    // Picks the widest kernel supported by the CPU
+    static KernelFunction SelectKernel()
+    {
+        for (auto kernel : {Kernel::Avx2, Kernel::Sse2})
+        {
+            if (auto function{GetKernelFunction(kernel)})
+            {
+                return function;
+            }
+        }
+        return FilterPortable;
+    }
+};
+
+FeedbackConstraint::FeedbackConstraint(std::string_view guess, std::string_view feedback) : green_bits(0),
+                                                                                             green_code(0),
+                                                                                             required_letters(0),
+                                                                                             forbidden_letters(0),
+                                                                                             num_excluded(0),
+                                                                                             num_counted(0)
+{
+    // Number of green and yellow marks and whether there was a black mark for each letter
+    uint8_t found[26]{};
+    bool black[26]{};
+
+    for (auto i{0}; i < WORD_LENGTH; i++)
+    {
+        auto letter{static_cast<uint32_t>(guess[i] - 'a')};
+        auto bits{((1u << LETTER_BITS) - 1) << (LETTER_BITS * i)};
+        if (feedback[i] == 'g')
+        {
+            green_bits |= bits;
+            green_code |= letter << (LETTER_BITS * i);
+            found[letter]++;
+        }
+        else
+        {
+            // Yellow and black both mean the letter is not at i
+            excluded_bits[num_excluded] = bits;
+            excluded_code[num_excluded] = letter << (LETTER_BITS * i);
+            num_excluded++;
+            if (feedback[i] == 'y')
+            {
+                found[letter]++;
+            }
+            else
+            {
+                black[letter] = true;
+            }
+        }
+    }
+
+    // Reduce the count bounds to letter masks where possible
+    for (auto i{0}; i < WORD_LENGTH; i++)
+    {
+        auto letter{static_cast<uint8_t>(guess[i] - 'a')};
+        if (found[letter] == 0)
+        {
+            forbidden_letters |= 1u << letter;
+            continue;
+        }
+
+        required_letters |= 1u << letter;
+        bool counted{false};
+        for (auto j{0}; j < num_counted; j++)
+        {
+            counted = counted || counted_letters[j] == letter;
+        }
+        if (!counted && (found[letter] > 1 || black[letter]))
+        {
+            counted_letters[num_counted] = letter;
+            min_counts[num_counted] = found[letter];
+            max_counts[num_counted] = black[letter] ? found[letter] : WORD_LENGTH;
+            num_counted++;
+        }
+    }
+}
+
+bool FeedbackConstraint::Matches(std::string_view word) const
+{
+    return Matches(EncodeWord(word), LetterMask(word));
+}
+
+bool FeedbackConstraint::Matches(uint32_t code, uint32_t mask) const
+{
+    if ((code & green_bits) != green_code || (mask & required_letters) != required_letters || (mask & forbidden_letters) != 0)
+    {
+        return false;
+    }
+
+    for (auto j{0}; j < num_excluded; j++)
+    {
+        if ((code & excluded_bits[j]) == excluded_code[j])
+        {
+            return false;
+        }
+    }
+
+    return num_counted == 0 || Private::CountsMatch(*this, code);
+}
+
+size_t FeedbackConstraint::Filter(uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t n) const
+{
+    // Picked on first use, initialization of a static local is thread safe
+    static const Private::KernelFunction kernel{Private::SelectKernel()};
+    return kernel(*this, ids, codes, masks, n);
+}
+
+size_t FeedbackConstraint::Filter(uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t n, Kernel kernel) const
+{
+    auto function{Private::GetKernelFunction(kernel)};
+    if (function == nullptr)
+    {
+        throw WordleSolverException("Filtering kernel is not supported on this CPU");
+    }
+    return function(*this, ids, codes, masks, n);
+}
+
+bool FeedbackConstraint::IsSupported(Kernel kernel)
+{
+    return Private::GetKernelFunction(kernel) != nullptr;
+}
@@ -0,0 +1,164 @@
+/*
+Header for FeedbackConstraint.
+
+This file declares the FeedbackConstraint class which compiles the feedback
+on a guess into a single constraint that can be checked against a word in
+one pass.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef CONSTRAINT_H
+#define CONSTRAINT_H
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include "dictionary.h"
+
+/*
+Constraint that a word must satisfy to be consistent with feedback on a guess.
+
+The feedback on a guess is turned into two kinds of constraints:
+
+1. For each position, which letters may be there. A green position only
+   allows the guessed letter there. A yellow or black position does not
+   allow the guessed letter there.
+2. For each letter in the guess, a minimum and maximum number of times it
+   can occur in the word. The minimum is the number of times the letter was
+   marked green or yellow. If the letter was also marked black somewhere, the
+   word cannot hold any more instances, so the maximum equals the minimum.
+
+A word satisfies the constraint exactly when it would have produced the same
+feedback for the guess. This handles repeated letters without any special
+cases, for instance the feedback "bybyb" for guess "three" means "e" occurs
+in the word exactly once and not at positions 2 or 4.
+
+The constraint is checked against packed words (see EncodeWord and LetterMask
+in dictionary.h). Most count constraints reduce to checking the letter mask
+(a letter must be present or must be absent), only a letter that must occur
+a particular number of times (more than once or exactly once) needs the
+letters of the word to be counted.
+*/
+class FeedbackConstraint
+{
+public:
+    // The filtering kernels (see Filter)
+    enum class Kernel
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /*
+    Compiles a constraint from a guess and its feedback.
+
+    Parameters:
+        guess: A 5 letter lowercase word.
+        feedback: Feedback for guess in the form of 5 y's, g's, and b's.
+    */
+    FeedbackConstraint(std::string_view guess, std::string_view feedback);
+
+    /*
+    Checks whether a word satisfies the constraint.
+
+    Parameters:
+        word: A 5 letter lowercase word.
+
+    Returns:
+        true if the word is consistent with the feedback, false otherwise.
+    */
+    bool Matches(std::string_view word) const;
+
+    /*
+    Checks whether a packed word satisfies the constraint.
+
+    Parameters:
+        code: EncodeWord of the word.
+        mask: LetterMask of the word.
+
+    Returns:
+        true if the word is consistent with the feedback, false otherwise.
+    */
+    bool Matches(uint32_t code, uint32_t mask) const;
+
+    /*
+    Keeps only the words that satisfy the constraint.
+
+    The words are given as 3 parallel arrays which are compacted in place,
+    preserving the relative order of the kept words. Uses an AVX2 or SSE2
+    kernel (8 or 4 words per instruction) when the CPU supports it, this is
+    picked once at runtime, otherwise uses a portable scalar loop.
+
+    Parameters:
+        ids: Ids of the words (carried along, not inspected).
+        codes: Packed codes of the words.
+        masks: Letter masks of the words.
+        n: Number of words.
+
+    Returns:
+        Number of words kept, these are now in the first entries of the arrays.
+    */
+    size_t Filter(uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t n) const;
+
+    /*
+    Version of Filter that uses a given kernel instead of the one picked at
+    runtime, so the kernels can be checked against each other (see
+    BenchmarkConstraintKernels in evaluation.h).
+
+    Parameters:
+        ids: Ids of the words (carried along, not inspected).
+        codes: Packed codes of the words.
+        masks: Letter masks of the words.
+        n: Number of words.
+        kernel: Kernel to filter with.
+
+    Returns:
+        Number of words kept, these are now in the first entries of the arrays.
+
+    Throws:
+        WordleSolverException if the kernel is not supported (see IsSupported).
+    */
+    size_t Filter(uint32_t *ids, uint32_t *codes, uint32_t *masks, size_t n, Kernel kernel) const;
+
+    /*
+    Checks whether a kernel can be used on this CPU and was built in.
+
+    Parameters:
+        kernel: The kernel.
+
+    Returns:
+        true if Filter can use the kernel, false otherwise. Scalar is always
+        supported.
+    */
+    static bool IsSupported(Kernel kernel);
+
+private:
+    // Bits of the letters at green positions and their required values
+    uint32_t green_bits;
+    uint32_t green_code;
+
+    // Letters that must occur in a word and letters that cannot
+    uint32_t required_letters;
+    uint32_t forbidden_letters;
+
+    // excluded_bits[j] is the bits of a yellow or black position and the
+    // word cannot have the value excluded_code[j] there
+    uint32_t excluded_bits[WORD_LENGTH];
+    uint32_t excluded_code[WORD_LENGTH];
+    uint8_t num_excluded;
+
+    // Letters (0-25) whose count in a word must be checked by counting, and
+    // the bounds on their counts
+    uint8_t counted_letters[WORD_LENGTH];
+    uint8_t min_counts[WORD_LENGTH];
+    uint8_t max_counts[WORD_LENGTH];
+    uint8_t num_counted;
+
+    // Inner class that holds the filtering kernels
+    class Private;
+};
+
+#endif
@@ -0,0 +1,399 @@
+// Implementation of Dictionary
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "dictionary.h"
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include "misc.h"
+#include "eligible_statistics.h"
+#include "popularity_ranking.h"
+
+bool IsWord(std::string_view word)
+{
+    return word.size() == WORD_LENGTH && word.find_first_not_of("abcdefghijklmnopqrstuvwxyz") == std::string_view::npos;
+}
+
+uint32_t EncodeWord(std::string_view word)
+{
+    uint32_t code{0};
+    for (auto i{0}; i < WORD_LENGTH; i++)
+    {
+        code |= static_cast<uint32_t>(word[i] - 'a') << (LETTER_BITS * i);
+    }
+    return code;
+}
+
+uint32_t LetterMask(std::string_view word)
+{
+    uint32_t mask{0};
+    for (auto c : word)
+    {
+        mask |= 1u << (c - 'a');
+    }
+    return mask;
+}
+
+// Header at the start of a compiled dictionary file, followed by the codes,
+// masks, sorted ids, popularity ranks (if num_popularity_ranks is not 0), and
+// letters of the words
+struct DictionaryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t word_length;
+    uint32_t num_words;
+    uint32_t num_popularity_ranks;
+    uint64_t checksum;
+    uint64_t popularity_checksum;
+    uint64_t source_size;
+    int64_t source_time;
+};
+
+// Identifies compiled dictionary files, version is increased if the layout changes
+static const char DICTIONARY_MAGIC[8]{'W', 'S', 'D', 'I', 'C', 'T', '\0', '\0'};
+static const uint32_t DICTIONARY_VERSION{1};
+
+class Dictionary::Private
+{
+public:
+    // Size in bytes of a compiled dictionary described by header
+    static size_t ImageSize(const DictionaryHeader &header)
+    {
+        return sizeof(header) + (3 * sizeof(uint32_t) + WORD_LENGTH) * static_cast<size_t>(header.num_words) +
+               sizeof(int32_t) * static_cast<size_t>(header.num_popularity_ranks);
+    }
+
+    // Gets the size and modification time of the text file a dictionary is
+    // compiled from, returns whether it could
+    static bool GetSource(const std::string &dictionary_fp, uint64_t &source_size, int64_t &source_time)
+    {
+        std::error_code error;
+        auto size{std::filesystem::file_size(dictionary_fp, error)};
+        if (error)
+        {
+            return false;
+        }
+        auto time{std::filesystem::last_write_time(dictionary_fp, error)};
+        if (error)
+        {
+            return false;
+        }
+        source_size = size;
+        source_time = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    // Reads the words of a dictionary file back to back
+    static std::string Read(const std::string &dictionary_fp)
+    {
+        std::ifstream dictionary_file(dictionary_fp, std::ios_base::in);
+        if (!dictionary_file.is_open())
+        {
+            throw WordleSolverException("Could not open " + dictionary_fp + " for reading");
+        }
+
+        std::string letters;
+        std::string word;
+        while (dictionary_file.good())
+        {
+            std::getline(dictionary_file, word);
+            if (word.empty())
+            {
+                continue;
+            }
+
+            // Every word must be 5 lowercase letters as the rest of the solver indexes
+            // letters and positions directly
+            if (!IsWord(word))
+            {
+                throw WordleSolverException("Invalid word [" + word + "] in " + dictionary_fp);
+            }
+            letters += word;
+        }
+
+        dictionary_file.close();
+        return letters;
+    }
+
+    // FNV-1a hash of the letters of the words (see http://www.isthe.com/chongo/tech/comp/fnv/)
+    static uint64_t Checksum(std::string_view letters)
+    {
+        uint64_t checksum{14695981039346656037ull};
+        for (auto c : letters)
+        {
+            checksum = (checksum ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return checksum;
+    }
+
+    // Checks that the words viewed by self are lowercase words that match the
+    // checksum, codes, and masks, and that the sorted ids are sorted by code
+    static bool IsValid(const Dictionary &self)
+    {
+        if (Checksum(self.letters) != self.checksum)
+        {
+            return false;
+        }
+        for (size_t id{0}; id < self.codes.size(); id++)
+        {
+            auto word{self.letters.substr(id * WORD_LENGTH, WORD_LENGTH)};
+            if (!IsWord(word) || self.codes[id] != EncodeWord(word) || self.masks[id] != LetterMask(word))
+            {
+                return false;
+            }
+        }
+        for (size_t i{0}; i < self.sorted_ids.size(); i++)
+        {
+            if (self.sorted_ids[i] >= self.codes.size() || (i > 0 && self.codes[self.sorted_ids[i - 1]] > self.codes[self.sorted_ids[i]]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Builds the compiled image of the words in letters (header.num_words,
+    // num_popularity_ranks, popularity_checksum, and source fields are
+    // expected to be filled in)
+    static std::vector<uint32_t> Build(std::string_view letters, DictionaryHeader header, std::span<const int32_t> popularity_ranks)
+    {
+        std::memcpy(header.magic, DICTIONARY_MAGIC, sizeof(DICTIONARY_MAGIC));
+        header.version = DICTIONARY_VERSION;
+        header.word_length = WORD_LENGTH;
+
+        header.checksum = Checksum(letters);
+
+        auto num_words{static_cast<size_t>(header.num_words)};
+        std::vector<uint32_t> image((ImageSize(header) + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+        auto bytes{reinterpret_cast<char *>(image.data())};
+        std::memcpy(bytes, &header, sizeof(header));
+        auto codes{image.data() + sizeof(header) / sizeof(uint32_t)};
+        auto masks{codes + num_words};
+        auto sorted_ids{masks + num_words};
+        for (size_t id{0}; id < num_words; id++)
+        {
+            auto word{letters.substr(id * WORD_LENGTH, WORD_LENGTH)};
+            codes[id] = EncodeWord(word);
+            masks[id] = LetterMask(word);
+            sorted_ids[id] = static_cast<uint32_t>(id);
+        }
+
+        // A stable sort keeps the first id of a repeated word first (Find returns it)
+        std::stable_sort(sorted_ids, sorted_ids + num_words, [codes](uint32_t a, uint32_t b)
+                         { return codes[a] < codes[b]; });
+
+        std::memcpy(sorted_ids + num_words, popularity_ranks.data(), popularity_ranks.size_bytes());
+        std::memcpy(reinterpret_cast<char *>(sorted_ids + num_words + popularity_ranks.size()), letters.data(), letters.size());
+        return image;
+    }
+
+    // Points the views of self into a compiled image (which is valid)
+    static void View(Dictionary &self, const char *data)
+    {
+        DictionaryHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        auto num_words{static_cast<size_t>(header.num_words)};
+        auto arrays{reinterpret_cast<const uint32_t *>(data + sizeof(header))};
+        self.codes = std::span<const uint32_t>(arrays, num_words);
+        self.masks = std::span<const uint32_t>(arrays + num_words, num_words);
+        self.sorted_ids = std::span<const uint32_t>(arrays + 2 * num_words, num_words);
+        auto ranks{reinterpret_cast<const int32_t *>(arrays + 3 * num_words)};
+        self.popularity_ranks = std::span<const int32_t>(ranks, header.num_popularity_ranks);
+        self.letters = std::string_view(reinterpret_cast<const char *>(ranks + header.num_popularity_ranks), num_words * WORD_LENGTH);
+        self.checksum = header.checksum;
+        self.popularity_checksum = header.popularity_checksum;
+    }
+
+    // Maps the compiled file at binary_fp and views it if it was compiled from
+    // self.dictionary_fp as it is now and is valid, returns whether it did
+    static bool Load(Dictionary &self, const std::string &binary_fp)
+    {
+        std::error_code error;
+        uint64_t source_size{0};
+        int64_t source_time{0};
+        if (!std::filesystem::exists(binary_fp, error) || !GetSource(self.dictionary_fp, source_size, source_time))
+        {
+            return false;
+        }
+
+        // A file that cannot be mapped is ignored like a stale one
+        std::unique_ptr<MappedFile> file;
+        try
+        {
+            file = std::make_unique<MappedFile>(binary_fp);
+        }
+        catch (const WordleSolverException &)
+        {
+            return false;
+        }
+
+        DictionaryHeader header;
+        if (file->Size() < sizeof(header))
+        {
+            return false;
+        }
+
+        std::memcpy(&header, file->Data(), sizeof(header));
+        if (std::memcmp(header.magic, DICTIONARY_MAGIC, sizeof(DICTIONARY_MAGIC)) != 0 || header.version != DICTIONARY_VERSION ||
+            header.word_length != WORD_LENGTH || header.source_size != source_size || header.source_time != source_time ||
+            (header.num_popularity_ranks != 0 && header.num_popularity_ranks != header.num_words) || file->Size() != ImageSize(header))
+        {
+            return false;
+        }
+
+        View(self, file->Data());
+        if (!IsValid(self))
+        {
+            return false;
+        }
+        self.file = std::move(file);
+        return true;
+    }
+};
+
+Dictionary::Dictionary(const std::string &fp) : dictionary_fp(fp)
+{
+    if (!Private::Load(*this, GetDefaultFilePath(fp)))
+    {
+        auto letters{Private::Read(fp)};
+        DictionaryHeader header{};
+        header.num_words = static_cast<uint32_t>(letters.size() / WORD_LENGTH);
+        image = Private::Build(letters, header, {});
+        Private::View(*this, reinterpret_cast<const char *>(image.data()));
+    }
+
+    auto all_statistics{std::make_shared<EligibleStatistics>()};
+    for (size_t id{0}; id < codes.size(); id++)
+    {
+        all_statistics->Add(codes[id], masks[id]);
+    }
+    statistics = all_statistics;
+}
+
+size_t Dictionary::Size() const
+{
+    return letters.size() / WORD_LENGTH;
+}
+
+std::string_view Dictionary::operator[](uint32_t id) const
+{
+    return std::string_view(letters.data() + static_cast<size_t>(id) * WORD_LENGTH, WORD_LENGTH);
+}
+
+bool Dictionary::Find(std::string_view word, uint32_t &id) const
+{
+    if (!IsWord(word))
+    {
+        return false;
+    }
+
+    auto code{EncodeWord(word)};
+    auto p{std::lower_bound(sorted_ids.begin(), sorted_ids.end(), code, [this](uint32_t id, uint32_t code)
+                            { return codes[id] < code; })};
+    if (p == sorted_ids.end() || codes[*p] != code)
+    {
+        return false;
+    }
+    id = *p;
+    return true;
+}
+
+uint64_t Dictionary::GetChecksum() const
+{
+    return checksum;
+}
+
+std::span<const uint32_t> Dictionary::GetCodes() const
+{
+    return codes;
+}
+
+std::span<const uint32_t> Dictionary::GetMasks() const
+{
+    return masks;
+}
+
+std::span<const int32_t> Dictionary::GetPopularityRanks() const
+{
+    return popularity_ranks;
+}
+
+uint64_t Dictionary::GetPopularityChecksum() const
+{
+    return popularity_checksum;
+}
+
+bool Dictionary::IsCompiled() const
+{
+    return file != nullptr;
+}
+
+const std::string &Dictionary::GetFilePath() const
+{
+    return dictionary_fp;
+}
+
+const std::shared_ptr<const EligibleStatistics> &Dictionary::GetStatistics() const
+{
+    return statistics;
+}
+
+void Dictionary::Compile(const std::string &dictionary_fp, const std::string &binary_fp)
+{
+    Compile(dictionary_fp, binary_fp, "");
+}
+
+void Dictionary::Compile(const std::string &dictionary_fp, const std::string &binary_fp, const std::string &freq_fp)
+{
+    // The source is checked before it is read so an edit made while compiling
+    // leaves the compiled file stale rather than silently out of date
+    DictionaryHeader header{};
+    if (!Private::GetSource(dictionary_fp, header.source_size, header.source_time))
+    {
+        throw WordleSolverException("Could not open " + dictionary_fp + " for reading");
+    }
+    auto letters{Private::Read(dictionary_fp)};
+    header.num_words = static_cast<uint32_t>(letters.size() / WORD_LENGTH);
+
+    std::vector<int32_t> popularity_ranks;
+    if (!freq_fp.empty())
+    {
+        auto ranking{PopularityRanking::Load(freq_fp)};
+        for (size_t id{0}; id < header.num_words; id++)
+        {
+            popularity_ranks.push_back(ranking->Find(std::string_view(letters).substr(id * WORD_LENGTH, WORD_LENGTH)));
+        }
+        header.num_popularity_ranks = header.num_words;
+        header.popularity_checksum = ranking->GetChecksum();
+    }
+    auto image{Private::Build(letters, header, popularity_ranks)};
+
+    // A temporary file is renamed into place so another process never maps a
+    // partially written dictionary
+    auto temp_fp{GetTempFilePath(binary_fp)};
+    std::ofstream binary_file(temp_fp, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!binary_file.is_open())
+    {
+        throw WordleSolverException("Could not open " + temp_fp + " for writing");
+    }
+    binary_file.write(reinterpret_cast<const char *>(image.data()), Private::ImageSize(header));
+    binary_file.close();
+    if (!binary_file)
+    {
+        std::error_code error;
+        std::filesystem::remove(temp_fp, error);
+        throw WordleSolverException("Could not write " + temp_fp);
+    }
+
+    ReplaceFile(temp_fp, binary_fp);
+}
+
+std::string Dictionary::GetDefaultFilePath(const std::string &dictionary_fp)
+{
+    std::filesystem::path binary_path{dictionary_fp};
+    auto stem{binary_path.stem().string()};
+    return binary_path.replace_filename(stem + "-dictionary.bin").string();
+}
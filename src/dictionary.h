@@ -0,0 +1,292 @@
+/*
+Header for Dictionary.
+
+This file declares the Dictionary class which holds a list of 5 letter
+words in memory so that WordleSolver and the rankers can work over
+the words without repeatedly reading them from disk. It also declares
+the packed integer encodings of words used by the hot loops and the
+compiled (binary) dictionary format.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <memory>
+#include "mapped_file.h"
+
+class EligibleStatistics;
+
+// Length of every word handled by the solver
+const unsigned short WORD_LENGTH{5};
+
+// Number of letters in the alphabet (a-z)
+const unsigned short NUM_LETTERS{26};
+
+// Number of bits used to store a letter (0-25) in a packed word code
+const unsigned short LETTER_BITS{5};
+
+/*
+Checks if a string is a word the solver can handle.
+
+Parameters:
+    word: String to check.
+
+Returns:
+    Whether word is 5 lowercase letters.
+*/
+bool IsWord(std::string_view word);
+
+/*
+Packs a word into a 32-bit code.
+
+Parameters:
+    word: A 5 letter lowercase word.
+
+Returns:
+    A code where bits [5i, 5i + 5) hold word[i] - 'a'.
+*/
+uint32_t EncodeWord(std::string_view word);
+
+/*
+Gets the letter at a position of a packed word.
+
+Parameters:
+    code: Packed word from EncodeWord.
+    i: Position (0-4).
+
+Returns:
+    The letter as 0-25.
+*/
+inline uint32_t CodeLetter(uint32_t code, unsigned short i)
+{
+    return (code >> (LETTER_BITS * i)) & ((1u << LETTER_BITS) - 1);
+}
+
+/*
+Computes the set of letters in a word.
+
+Parameters:
+    word: A 5 letter lowercase word.
+
+Returns:
+    A 26-bit mask where bit c is set if 'a' + c occurs in word.
+*/
+uint32_t LetterMask(std::string_view word);
+
+/*
+In-memory list of 5 letter words.
+
+The words are read once from a file (one word per line) and stored
+back to back in a single string so that a word can be accessed by its
+index (referred to as its id) without any allocation. Ids are assigned
+in the order the words appear in the file, so iterating over the ids
+in increasing order visits the words in file order.
+
+Alongside the letters, the packed code (EncodeWord) and letter mask
+(LetterMask) of every word are stored in separate arrays indexed by id
+(structure-of-arrays) so that filters can stream over them.
+
+A dictionary can be compiled (see Compile) into a binary file that holds a
+header (version, word length, number of words, checksum, and the size and
+modification time of the text file it was compiled from) followed by the
+codes, the masks, the ids sorted by code, optionally the popularity ranks of
+the words, and the letters. A dictionary loaded from text is stored in the
+same layout in memory, so either way the arrays are views into one image.
+Copying is disabled as the views point into the object.
+*/
+class Dictionary
+{
+public:
+    /*
+    Loads a Dictionary from a file.
+
+    If the compiled file at GetDefaultFilePath(fp) was compiled from fp as it
+    is now, it is memory-mapped and used in place instead, so nothing is
+    copied. Its words are still validated in full: the checksum is
+    recomputed and every word, code, mask, and sorted id is checked, which is
+    a single pass over the words but no longer the cost of a plain mmap.
+    Otherwise (it is missing, stale, from another version, cannot be mapped,
+    or fails those checks) fp is read as text. A compiled file is stale if
+    fp's size or modification time changed since it was compiled, so an
+    edit to fp that keeps both (e.g. a copy with preserved times) is not
+    detected; run Compile again after such edits.
+
+    Parameters:
+        fp: Path to the dictionary file. Each word should be on a separate
+        line and be made up of 5 lowercase letters. Empty lines are ignored.
+
+    Throws:
+        WordleSolverException if the file cannot be opened or holds a line
+        that is not a 5 letter lowercase word.
+    */
+    Dictionary(const std::string &fp);
+
+    Dictionary(const Dictionary &) = delete;
+    Dictionary &operator=(const Dictionary &) = delete;
+
+    /*
+    Gets the number of words in the dictionary.
+
+    Returns:
+        The number of words.
+    */
+    size_t Size() const;
+
+    /*
+    Gets a word given its id.
+
+    Parameters:
+        id: Id of the word (0...Size()-1), not bounds checked.
+
+    Returns:
+        A view of the word that remains valid for the lifetime of the Dictionary.
+    */
+    std::string_view operator[](uint32_t id) const;
+
+    /*
+    Finds the id of a word.
+
+    Parameters:
+        word: A 5 letter lowercase word.
+        id: Will store the id of word if it is in the dictionary.
+
+    Returns:
+        true if word is in the dictionary, false otherwise.
+    */
+    bool Find(std::string_view word, uint32_t &id) const;
+
+    /*
+    Gets a checksum of the words.
+
+    Returns:
+        A 64-bit FNV-1a hash of the words in order. Used to check that data
+        computed for a dictionary and saved to disk (e.g. a FeedbackMatrix)
+        still matches the dictionary.
+    */
+    uint64_t GetChecksum() const;
+
+    // Packed codes (see EncodeWord) of the words indexed by id.
+    std::span<const uint32_t> GetCodes() const;
+
+    // Letter masks (see LetterMask) of the words indexed by id.
+    std::span<const uint32_t> GetMasks() const;
+
+    // Popularity ranks of the words indexed by id that were compiled with
+    // the dictionary (see Compile), empty if there are none.
+    std::span<const int32_t> GetPopularityRanks() const;
+
+    // Checksum of the frequency file GetPopularityRanks() were compiled from
+    // (see PopularityRanking::GetChecksum).
+    uint64_t GetPopularityChecksum() const;
+
+    // Whether the dictionary was loaded from a compiled file.
+    bool IsCompiled() const;
+
+    /*
+    Gets the statistics of all of the words.
+
+    These are computed once when the dictionary is loaded and are shared by
+    every EligibleWords that has all of the words eligible (i.e. every first
+    guess of every solver using the dictionary).
+
+    Returns:
+        The statistics (see EligibleStatistics).
+    */
+    const std::shared_ptr<const EligibleStatistics> &GetStatistics() const;
+
+    /*
+    Gets the path of the file the dictionary was loaded from.
+
+    Returns:
+        The file path.
+    */
+    const std::string &GetFilePath() const;
+
+    /*
+    Compiles a dictionary file into a binary file.
+
+    Parameters:
+        dictionary_fp: Path to a dictionary file (see Dictionary()).
+        binary_fp: Path to write the compiled dictionary to.
+
+    Throws:
+        WordleSolverException if dictionary_fp cannot be read or binary_fp
+        cannot be written.
+    */
+    static void Compile(const std::string &dictionary_fp, const std::string &binary_fp);
+
+    /*
+    Overloaded version of Compile(const std::string&,const std::string&) that also compiles the popularity ranks of the words.
+
+    Parameters:
+        dictionary_fp: Path to a dictionary file (see Dictionary()).
+        binary_fp: Path to write the compiled dictionary to.
+        freq_fp: Path to a frequency file (see PopularityRanking()).
+
+    Throws:
+        WordleSolverException if a file cannot be read or binary_fp cannot
+        be written.
+    */
+    static void Compile(const std::string &dictionary_fp, const std::string &binary_fp, const std::string &freq_fp);
+
+    /*
+    Gets the default path of the compiled file for a dictionary.
+
+    Parameters:
+        dictionary_fp: Path to a dictionary file.
+
+    Returns:
+        Path with the extension replaced, e.g. "a.txt" -> "a-dictionary.bin".
+    */
+    static std::string GetDefaultFilePath(const std::string &dictionary_fp);
+
+private:
+    /*
+    Inner class that holds private helper functions of Dictionary. See
+    https://stackoverflow.com/a/28734794.
+    */
+    class Private;
+
+    // Path to the file the words were loaded from
+    std::string dictionary_fp;
+
+    // Compiled file the dictionary was loaded from (nullptr if read as text)
+    std::unique_ptr<MappedFile> file;
+
+    // Compiled image of the dictionary when it was read as text (stored as
+    // uint32_t so the arrays in it are aligned)
+    std::vector<uint32_t> image;
+
+    // Words stored back to back, word i occupies [i * WORD_LENGTH, (i + 1) * WORD_LENGTH)
+    std::string_view letters;
+
+    // codes[i] is EncodeWord of word i
+    std::span<const uint32_t> codes;
+
+    // masks[i] is LetterMask of word i
+    std::span<const uint32_t> masks;
+
+    // Ids ordered by code, ties in increasing order (used by Find)
+    std::span<const uint32_t> sorted_ids;
+
+    // Compiled popularity ranks (see GetPopularityRanks)
+    std::span<const int32_t> popularity_ranks;
+    uint64_t popularity_checksum;
+
+    // Checksum of letters
+    uint64_t checksum;
+
+    // Statistics of all of the words
+    std::shared_ptr<const EligibleStatistics> statistics;
+};
+
+#endif
@@ -3,7 +3,6 @@
 // Date: Summer 2022
 
 #include "duplicate_ranker.h"
-#include <unordered_set>
 #include <algorithm>
 
 DuplicateRanker::DuplicateRanker(AbstractRanker *r, int dp) : DuplicateRanker(r, dp, 7) {}
@@ -11,10 +10,10 @@ DuplicateRanker::DuplicateRanker(AbstractRanker *r, int dp, unsigned short ng) :
 DuplicateRanker::DuplicateRanker(std::string_view name, AbstractRanker *r, int dp) : DuplicateRanker(name, r, dp, 7) {}
 DuplicateRanker::DuplicateRanker(std::string_view name, AbstractRanker *r, int dp, unsigned short ng) : AbstractRanker(name), ranker(r), duplicate_penalty(dp), num_guesses(ng) {}
 
-void DuplicateRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void DuplicateRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
     curr_guess = guess;
-    ranker->SetUp(eligible_fp, guess, feedback);
+    ranker->SetUp(eligible, guess, feedback);
 }
 
 int DuplicateRanker::Rank(std::string_view word) const
@@ -24,12 +23,40 @@ int DuplicateRanker::Rank(std::string_view word) const
         return ranker->Rank(word);
     }
 
-    std::unordered_set<char> uniq_letters;
-    for (auto c : word)
+    return ranker->Rank(word) + (duplicate_penalty * CountDuplicates(LetterMask(word)));
+}
+
+void DuplicateRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    ranker->RankAllExact(words, ranks);
+    if (curr_guess > num_guesses)
     {
-        uniq_letters.insert(c);
+        return;
     }
-    return ranker->Rank(word) + (duplicate_penalty * (word.size() - uniq_letters.size()));
+
+    for (size_t i{0}; i < words.size(); i++)
+    {
+        ranks[i] += duplicate_penalty * CountDuplicates(words[i].mask);
+    }
+}
+
+std::unique_ptr<AbstractRanker> DuplicateRanker::Clone() const
+{
+    // Copy parameters then replace the shared passed ranker with a clone of it
+    auto clone{std::make_unique<DuplicateRanker>(*this)};
+    clone->owned_ranker = ranker->Clone();
+    clone->ranker = clone->owned_ranker.get();
+    return clone;
+}
+
+bool DuplicateRanker::IsDeterministic() const
+{
+    return ranker->IsDeterministic();
+}
+
+uint64_t DuplicateRanker::GetDataChecksum() const
+{
+    return ranker->GetDataChecksum();
 }
 
 std::string DuplicateRanker::GetDebugInfo() const
@@ -42,10 +69,10 @@ ProgressDuplicateRanker::ProgressDuplicateRanker(AbstractRanker *r, int dp, unsi
 ProgressDuplicateRanker::ProgressDuplicateRanker(std::string_view name, AbstractRanker *r, int dp) : ProgressDuplicateRanker(name, r, dp, 6) {}
 ProgressDuplicateRanker::ProgressDuplicateRanker(std::string_view name, AbstractRanker *r, int dp, unsigned short nf) : AbstractRanker(name), ranker(r), duplicate_penalty(dp), num_found(nf) {}
 
-void ProgressDuplicateRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void ProgressDuplicateRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
     curr_found = feedback.size() - std::count(feedback.cbegin(), feedback.cend(), 'b');
-    ranker->SetUp(eligible_fp, guess, feedback);
+    ranker->SetUp(eligible, guess, feedback);
 }
 
 int ProgressDuplicateRanker::Rank(std::string_view word) const
@@ -55,12 +82,40 @@ int ProgressDuplicateRanker::Rank(std::string_view word) const
         return ranker->Rank(word);
     }
 
-    std::unordered_set<char> uniq_letters;
-    for (auto c : word)
+    return ranker->Rank(word) + (duplicate_penalty * CountDuplicates(LetterMask(word)));
+}
+
+void ProgressDuplicateRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    ranker->RankAllExact(words, ranks);
+    if (curr_found >= num_found)
     {
-        uniq_letters.insert(c);
+        return;
     }
-    return ranker->Rank(word) + (duplicate_penalty * (word.size() - uniq_letters.size()));
+
+    for (size_t i{0}; i < words.size(); i++)
+    {
+        ranks[i] += duplicate_penalty * CountDuplicates(words[i].mask);
+    }
+}
+
+std::unique_ptr<AbstractRanker> ProgressDuplicateRanker::Clone() const
+{
+    // Copy parameters then replace the shared passed ranker with a clone of it
+    auto clone{std::make_unique<ProgressDuplicateRanker>(*this)};
+    clone->owned_ranker = ranker->Clone();
+    clone->ranker = clone->owned_ranker.get();
+    return clone;
+}
+
+bool ProgressDuplicateRanker::IsDeterministic() const
+{
+    return ranker->IsDeterministic();
+}
+
+uint64_t ProgressDuplicateRanker::GetDataChecksum() const
+{
+    return ranker->GetDataChecksum();
 }
 
 std::string ProgressDuplicateRanker::GetDebugInfo() const
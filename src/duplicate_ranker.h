@@ -11,6 +11,23 @@ Date: Summer 2022
 #define DUPLICATE_RANKER_H
 
 #include "ranker.h"
+#include <bit>
+#include <cstdint>
+
+/*
+Counts the duplicate letters in a word.
+
+Parameters:
+    mask: Letter mask of the word (see LetterMask).
+
+Returns:
+    The number of letters that repeat an earlier letter, i.e. the word's
+    length less the number of distinct letters (set bits of mask).
+*/
+inline int CountDuplicates(uint32_t mask)
+{
+    return WORD_LENGTH - std::popcount(mask);
+}
 
 /*
 A ranker that penalizes the presences of duplicates in another ranker.
@@ -72,12 +89,12 @@ public:
     Sets up this ranker by calling SetUp on the AbstractRanker passed via the constructor.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes a rank using the passed AbstractRanker and potentially a duplicate penalty.
@@ -96,6 +113,18 @@ public:
     */
     virtual int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Returns IsDeterministic() as defined by the passed ranker.
+    virtual bool IsDeterministic() const override;
+
+    // Returns GetDataChecksum() as defined by the passed ranker.
+    virtual uint64_t GetDataChecksum() const override;
+
     // Returns GetDebugInfo() as defined by the passed ranker.
     virtual std::string GetDebugInfo() const override;
 
@@ -103,6 +132,9 @@ private:
     // Passed ranker (used to implement SetUp, Rank, GetDebugInfo)
     AbstractRanker *ranker;
 
+    // Owns the passed ranker when this ranker is a clone (ranker points to it)
+    std::shared_ptr<AbstractRanker> owned_ranker;
+
     // Duplicate penalty (dp in constructors) applied to each duplicate instance
     int duplicate_penalty;
 
@@ -174,12 +206,12 @@ public:
     Sets up this ranker by calling SetUp on the AbstractRanker passed via the constructor.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes a rank using the passed AbstractRanker and potentially a duplicate penalty.
@@ -198,12 +230,27 @@ public:
     */
     virtual int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Returns IsDeterministic() as defined by the passed ranker.
+    virtual bool IsDeterministic() const override;
+
+    // Returns GetDataChecksum() as defined by the passed ranker.
+    virtual uint64_t GetDataChecksum() const override;
+
     // Returns GetDebugInfo() as defined by the passed ranker.
     virtual std::string GetDebugInfo() const override;
 private:
     // Passed ranker (used to implement SetUp, Rank, GetDebugInfo)
     AbstractRanker *ranker;
 
+    // Owns the passed ranker when this ranker is a clone (ranker points to it)
+    std::shared_ptr<AbstractRanker> owned_ranker;
+
     // Duplicate penalty (dp in constructors) applied to each duplicate instance
     int duplicate_penalty;
 
@@ -0,0 +1,129 @@
+// Implementation of EligibleStatistics
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "eligible_statistics.h"
+#include <algorithm>
+#include <bit>
+
+EligibleStatistics::EligibleStatistics() : num_words(0)
+{
+    letter_counts.fill(0);
+    for (auto &counts : position_counts)
+    {
+        counts.fill(0);
+    }
+
+    size_t num_codes{NUM_LETTERS};
+    for (auto n{MIN_SUBSTRING_LEN}; n <= MAX_SUBSTRING_LEN; n++)
+    {
+        num_codes *= NUM_LETTERS;
+        substring_counts[n - MIN_SUBSTRING_LEN].assign(num_codes, 0);
+    }
+}
+
+void EligibleStatistics::Add(uint32_t code, uint32_t mask)
+{
+    num_words++;
+
+    // Unique letters are the set bits of the mask
+    for (; mask != 0; mask &= mask - 1)
+    {
+        letter_counts[std::countr_zero(mask)]++;
+    }
+
+    for (unsigned short i{0}; i < WORD_LENGTH; i++)
+    {
+        position_counts[i][CodeLetter(code, i)]++;
+    }
+
+    // Each substring is counted once per word (a word has at most 4 of a length)
+    for (auto n{MIN_SUBSTRING_LEN}; n <= MAX_SUBSTRING_LEN; n++)
+    {
+        auto &counts{substring_counts[n - MIN_SUBSTRING_LEN]};
+        auto &present{substrings[n - MIN_SUBSTRING_LEN]};
+        uint32_t word_substrs[WORD_LENGTH];
+        for (unsigned short i{0}; i + n <= WORD_LENGTH; i++)
+        {
+            auto substr{SubstringCode(code, i, n)};
+            word_substrs[i] = substr;
+            if (std::find(word_substrs, word_substrs + i, substr) != word_substrs + i)
+            {
+                continue;
+            }
+            if (counts[substr]++ == 0)
+            {
+                present.push_back(substr);
+            }
+        }
+    }
+}
+
+void EligibleStatistics::Remove(std::span<const uint32_t> codes, std::span<const uint32_t> masks)
+{
+    num_words -= codes.size();
+    for (size_t w{0}; w < codes.size(); w++)
+    {
+        auto code{codes[w]};
+        for (auto mask{masks[w]}; mask != 0; mask &= mask - 1)
+        {
+            letter_counts[std::countr_zero(mask)]--;
+        }
+
+        for (unsigned short i{0}; i < WORD_LENGTH; i++)
+        {
+            position_counts[i][CodeLetter(code, i)]--;
+        }
+
+        // Mirrors Add: each substring was counted once per word
+        for (auto n{MIN_SUBSTRING_LEN}; n <= MAX_SUBSTRING_LEN; n++)
+        {
+            auto &counts{substring_counts[n - MIN_SUBSTRING_LEN]};
+            uint32_t word_substrs[WORD_LENGTH];
+            for (unsigned short i{0}; i + n <= WORD_LENGTH; i++)
+            {
+                auto substr{SubstringCode(code, i, n)};
+                word_substrs[i] = substr;
+                if (std::find(word_substrs, word_substrs + i, substr) == word_substrs + i)
+                {
+                    counts[substr]--;
+                }
+            }
+        }
+    }
+
+    // Drop substrings that no longer appear (once, rather than per word)
+    for (auto n{MIN_SUBSTRING_LEN}; n <= MAX_SUBSTRING_LEN; n++)
+    {
+        const auto &counts{substring_counts[n - MIN_SUBSTRING_LEN]};
+        auto &present{substrings[n - MIN_SUBSTRING_LEN]};
+        present.erase(std::remove_if(present.begin(), present.end(), [&counts](uint32_t substr)
+                                     { return counts[substr] == 0; }),
+                      present.end());
+    }
+}
+
+size_t EligibleStatistics::GetNumWords() const
+{
+    return num_words;
+}
+
+const std::array<size_t, NUM_LETTERS> &EligibleStatistics::GetLetterCounts() const
+{
+    return letter_counts;
+}
+
+const std::array<size_t, NUM_LETTERS> &EligibleStatistics::GetPositionCounts(unsigned short i) const
+{
+    return position_counts[i];
+}
+
+const std::vector<uint32_t> &EligibleStatistics::GetSubstringCounts(unsigned short n) const
+{
+    return substring_counts[n - MIN_SUBSTRING_LEN];
+}
+
+const std::vector<uint32_t> &EligibleStatistics::GetSubstrings(unsigned short n) const
+{
+    return substrings[n - MIN_SUBSTRING_LEN];
+}
@@ -0,0 +1,146 @@
+/*
+Header for EligibleStatistics.
+
+This file declares the EligibleStatistics class which holds the letter,
+position, and substring counts of a set of words that the rankers build
+their rankings from.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef ELIGIBLE_STATISTICS_H
+#define ELIGIBLE_STATISTICS_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <span>
+#include "dictionary.h"
+
+/*
+Gets the code of a substring of a packed word.
+
+Parameters:
+    code: Packed word from EncodeWord.
+    i: Position the substring starts at.
+    n: Length of the substring (i + n <= 5).
+
+Returns:
+    The letters of the substring as a base 26 number (first letter most
+    significant), in [0, 26^n).
+*/
+inline uint32_t SubstringCode(uint32_t code, unsigned short i, unsigned short n)
+{
+    uint32_t substring_code{0};
+    for (auto j{i}; j < i + n; j++)
+    {
+        substring_code = substring_code * NUM_LETTERS + CodeLetter(code, j);
+    }
+    return substring_code;
+}
+
+/*
+Counts computed from a set of words in a single pass.
+
+For each letter, the number of words it appears in (and at each position)
+and for each 2 and 3 letter substring, the number of words it appears in.
+These are the statistics LetterRanker, PositionRanker, and SubstringRanker
+(and so CombinedRanker) rank with. They are computed once per set of eligible
+words (see EligibleWords::GetStatistics) and shared by all of the rankers in
+a chain, instead of each ranker reading the words again. The statistics of a
+whole Dictionary are computed once and shared by every solver using it.
+
+Words can be added and removed, so the statistics of the eligible words
+after feedback can be derived from those before it by removing the words
+the feedback eliminated.
+*/
+class EligibleStatistics
+{
+public:
+    // Shortest and longest substrings that are counted
+    static const unsigned short MIN_SUBSTRING_LEN{2};
+    static const unsigned short MAX_SUBSTRING_LEN{3};
+
+    // Creates the statistics of no words.
+    EligibleStatistics();
+
+    /*
+    Adds a word to the counts.
+
+    Parameters:
+        code: Packed word (see EncodeWord).
+        mask: Letter mask of the word (see LetterMask).
+    */
+    void Add(uint32_t code, uint32_t mask);
+
+    /*
+    Removes words from the counts.
+
+    This lets the statistics of a smaller set of words be derived from those
+    of a larger one in time proportional to the number of words removed.
+
+    Parameters:
+        codes: Packed words to remove, each must have been added.
+        masks: Letter masks of the words to remove, parallel to codes.
+    */
+    void Remove(std::span<const uint32_t> codes, std::span<const uint32_t> masks);
+
+    // Number of words added (and not removed).
+    size_t GetNumWords() const;
+
+    // Number of words each letter (as 0-25) appears in.
+    const std::array<size_t, NUM_LETTERS> &GetLetterCounts() const;
+
+    /*
+    Gets the number of words each letter appears in at a position.
+
+    Parameters:
+        i: Position (0-4).
+
+    Returns:
+        The counts indexed by letter (as 0-25).
+    */
+    const std::array<size_t, NUM_LETTERS> &GetPositionCounts(unsigned short i) const;
+
+    /*
+    Gets the number of words each n letter substring appears in.
+
+    Parameters:
+        n: Substring length (MIN_SUBSTRING_LEN...MAX_SUBSTRING_LEN).
+
+    Returns:
+        The counts indexed by substring code (see SubstringCode), 26^n entries.
+    */
+    const std::vector<uint32_t> &GetSubstringCounts(unsigned short n) const;
+
+    /*
+    Gets the n letter substrings that appear in the words.
+
+    Parameters:
+        n: Substring length (MIN_SUBSTRING_LEN...MAX_SUBSTRING_LEN).
+
+    Returns:
+        The codes of the substrings with a non-zero count (in no particular order).
+    */
+    const std::vector<uint32_t> &GetSubstrings(unsigned short n) const;
+
+private:
+    // Number of words added
+    size_t num_words;
+
+    // letter_counts[c] is the number of words with letter c
+    std::array<size_t, NUM_LETTERS> letter_counts;
+
+    // position_counts[i][c] is the number of words with letter c at position i
+    std::array<size_t, NUM_LETTERS> position_counts[WORD_LENGTH];
+
+    // substring_counts[n - MIN_SUBSTRING_LEN] and substrings[n - MIN_SUBSTRING_LEN]
+    // hold the counts and present codes of the n letter substrings
+    std::vector<uint32_t> substring_counts[MAX_SUBSTRING_LEN - MIN_SUBSTRING_LEN + 1];
+    std::vector<uint32_t> substrings[MAX_SUBSTRING_LEN - MIN_SUBSTRING_LEN + 1];
+};
+
+#endif
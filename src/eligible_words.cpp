@@ -0,0 +1,160 @@
+// Implementation of EligibleWords
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "eligible_words.h"
+#include "fingerprint_cache.h"
+#include <numeric>
+
+EligibleWords::EligibleWords(const Dictionary *d) : dictionary(d), ids(d->Size()), codes(d->GetCodes().begin(), d->GetCodes().end()), masks(d->GetMasks().begin(), d->GetMasks().end()), statistics(d->GetStatistics())
+{
+    std::iota(ids.begin(), ids.end(), 0);
+}
+
+EligibleWords::EligibleWords(const std::string &fp) : dictionary(nullptr), eligible_fp(fp) {}
+
+bool EligibleWords::IsInMemory() const
+{
+    return dictionary != nullptr;
+}
+
+const Dictionary *EligibleWords::GetDictionary() const
+{
+    return dictionary;
+}
+
+const std::vector<uint32_t> &EligibleWords::GetIds() const
+{
+    return ids;
+}
+
+const std::vector<uint32_t> &EligibleWords::GetCodes() const
+{
+    return codes;
+}
+
+const std::vector<uint32_t> &EligibleWords::GetMasks() const
+{
+    return masks;
+}
+
+const std::string &EligibleWords::GetFilePath() const
+{
+    return eligible_fp;
+}
+
+void EligibleWords::GetWords(std::vector<Word> &words, std::vector<std::string> &texts) const
+{
+    words.clear();
+    if (IsInMemory())
+    {
+        words.reserve(ids.size());
+        for (size_t i{0}; i < ids.size(); i++)
+        {
+            words.push_back(Word{(*dictionary)[ids[i]], ids[i], codes[i], masks[i]});
+        }
+        return;
+    }
+
+    // Words are read first as texts may reallocate while it grows
+    texts.clear();
+    ForEach([&texts](std::string_view word)
+            {
+        if (!IsWord(word))
+        {
+            throw WordleSolverException("Invalid word [" + std::string(word) + "] in eligible words");
+        }
+        texts.emplace_back(word); });
+
+    words.reserve(texts.size());
+    for (const auto &text : texts)
+    {
+        words.push_back(Word{text, Word::NO_ID, EncodeWord(text), LetterMask(text)});
+    }
+}
+
+const EligibleStatistics &EligibleWords::GetStatistics() const
+{
+    if (statistics)
+    {
+        return *statistics;
+    }
+
+    auto new_statistics{std::make_shared<EligibleStatistics>()};
+    if (IsInMemory())
+    {
+        for (size_t i{0}; i < ids.size(); i++)
+        {
+            new_statistics->Add(codes[i], masks[i]);
+        }
+    }
+    else
+    {
+        ForEach([&new_statistics](std::string_view word)
+                {
+            if (!IsWord(word))
+            {
+                throw WordleSolverException("Invalid word [" + std::string(word) + "] in eligible words");
+            }
+            new_statistics->Add(EncodeWord(word), LetterMask(word)); });
+    }
+    statistics = new_statistics;
+    return *statistics;
+}
+
+uint64_t EligibleWords::GetFingerprint() const
+{
+    if (!IsInMemory())
+    {
+        throw WordleSolverException("File-backed eligible words do not have a fingerprint");
+    }
+
+    // The ids are combined with XOR so the fingerprint does not depend on their order
+    auto fingerprint{dictionary->GetChecksum()};
+    for (auto id : ids)
+    {
+        fingerprint ^= MixFingerprint(id);
+    }
+    return MixFingerprint(fingerprint + ids.size());
+}
+
+void EligibleWords::InvalidateStatistics()
+{
+    statistics.reset();
+}
+
+void EligibleWords::UpdateStatistics(const std::vector<uint32_t> &prev_ids, const std::vector<uint32_t> &prev_codes, const std::vector<uint32_t> &prev_masks)
+{
+    auto num_removed{prev_ids.size() - ids.size()};
+    if (!statistics || num_removed >= ids.size())
+    {
+        InvalidateStatistics();
+        return;
+    }
+    if (num_removed == 0)
+    {
+        return;
+    }
+
+    // Both id lists are increasing, so the removed words are the previous
+    // words that are skipped while walking through the kept ones
+    std::vector<uint32_t> removed_codes;
+    std::vector<uint32_t> removed_masks;
+    removed_codes.reserve(num_removed);
+    removed_masks.reserve(num_removed);
+    size_t kept{0};
+    for (size_t i{0}; i < prev_ids.size(); i++)
+    {
+        if (kept < ids.size() && ids[kept] == prev_ids[i])
+        {
+            kept++;
+            continue;
+        }
+        removed_codes.push_back(prev_codes[i]);
+        removed_masks.push_back(prev_masks[i]);
+    }
+
+    auto new_statistics{std::make_shared<EligibleStatistics>(*statistics)};
+    new_statistics->Remove(removed_codes, removed_masks);
+    statistics = new_statistics;
+}
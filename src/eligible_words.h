@@ -0,0 +1,233 @@
+/*
+Header for EligibleWords.
+
+This file declares the EligibleWords class which is how WordleSolver
+presents the words that remain eligible after processing feedback to
+an AbstractRanker.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef ELIGIBLE_WORDS_H
+#define ELIGIBLE_WORDS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "dictionary.h"
+#include "eligible_statistics.h"
+#include <memory>
+#include "misc.h"
+
+/*
+An eligible word along with its precomputed encodings.
+
+This is what AbstractRanker::RankAll receives so that rankers can work on
+the packed representations instead of the letters.
+*/
+struct Word
+{
+    // Id used for words that are not in memory (file-backed)
+    static constexpr uint32_t NO_ID{UINT32_MAX};
+
+    // The word's letters
+    std::string_view text;
+
+    // Id of the word in its Dictionary (NO_ID when file-backed)
+    uint32_t id;
+
+    // Packed code of the word (see EncodeWord)
+    uint32_t code;
+
+    // Letter mask of the word (see LetterMask)
+    uint32_t mask;
+};
+
+/*
+Set of words that are still eligible to be guessed.
+
+The set is stored in one of two ways. By default it is kept in memory
+as the ids of the eligible words in a Dictionary (in increasing order).
+Alternatively, it is kept in a file (one word per line) for dictionaries
+that may not fit in memory. Rankers should visit the words with ForEach
+which works with either representation.
+*/
+class EligibleWords
+{
+public:
+    /*
+    Creates an in-memory set of eligible words.
+
+    Initially, every word in the dictionary is eligible.
+
+    Parameters:
+        d: Dictionary the ids refer to, must outlive this object.
+    */
+    EligibleWords(const Dictionary *d);
+
+    /*
+    Creates a set of eligible words that is backed by a file.
+
+    Parameters:
+        fp: Path to the file holding the eligible words, one per line.
+    */
+    EligibleWords(const std::string &fp);
+
+    // Whether the words are stored in memory (true) or in a file (false).
+    bool IsInMemory() const;
+
+    // Dictionary the ids refer to (nullptr when file-backed).
+    const Dictionary *GetDictionary() const;
+
+    // Ids of the eligible words in increasing order (empty when file-backed).
+    const std::vector<uint32_t> &GetIds() const;
+
+    // Packed codes of the eligible words, parallel to GetIds() (empty when file-backed).
+    const std::vector<uint32_t> &GetCodes() const;
+
+    // Letter masks of the eligible words, parallel to GetIds() (empty when file-backed).
+    const std::vector<uint32_t> &GetMasks() const;
+
+    // Path to the eligible words file (empty when in memory).
+    const std::string &GetFilePath() const;
+
+    /*
+    Gets the letter, position, and substring counts of the eligible words.
+
+    The statistics are computed in one pass over the words the first time
+    they are asked for and then kept until the eligible words change, so
+    all of the rankers set up on the same eligible words share them. When
+    every word of the dictionary is eligible, the dictionary's statistics
+    are used (see Dictionary::GetStatistics).
+
+    Returns:
+        The statistics, valid until the eligible words change.
+
+    Throws:
+        WordleSolverException if the words are file-backed and the file cannot
+        be opened or holds a line that is not a word (see IsWord).
+    */
+    const EligibleStatistics &GetStatistics() const;
+
+    /*
+    Gets a fingerprint of the eligible words.
+
+    The fingerprint combines the scrambled ids of the words (see MixFingerprint)
+    with the dictionary's checksum, so sets of words (of any dictionary) are
+    identified by their fingerprints (see FingerprintCache).
+
+    Returns:
+        A 64-bit fingerprint of the words.
+
+    Throws:
+        WordleSolverException if the words are file-backed.
+    */
+    uint64_t GetFingerprint() const;
+
+    /*
+    Gets the eligible words for batch processing.
+
+    Parameters:
+        words: Cleared then filled with the eligible words in dictionary order.
+        texts: When file-backed, cleared then filled with the letters of the
+               words (the texts of words refer to it). Unused in memory.
+
+    Throws:
+        WordleSolverException if the words are file-backed and the file cannot
+        be opened or holds a line that is not a word (see IsWord).
+    */
+    void GetWords(std::vector<Word> &words, std::vector<std::string> &texts) const;
+
+    /*
+    Calls a function on each eligible word.
+
+    Words are visited in dictionary order. Implementation in header because
+    it is a template, see CountsToRanks in misc.h.
+
+    Template:
+        Functor: Function object, function pointer, or lambda that takes a
+        std::string_view.
+
+    Parameters:
+        f: Function to call on each word.
+
+    Throws:
+        WordleSolverException if the words are file-backed and the file cannot
+        be opened.
+    */
+    template <typename Functor>
+    void ForEach(const Functor &f) const
+    {
+        if (IsInMemory())
+        {
+            for (auto id : ids)
+            {
+                f((*dictionary)[id]);
+            }
+            return;
+        }
+
+        std::ifstream eligible_file(eligible_fp, std::ios_base::in);
+        if (!eligible_file.is_open())
+        {
+            throw WordleSolverException("Could not open " + eligible_fp + " for reading");
+        }
+
+        std::string word;
+        while (eligible_file.good())
+        {
+            std::getline(eligible_file, word);
+
+            // Empty line means the file is empty (an empty file has 1 empty line)
+            if (!word.empty())
+            {
+                f(word);
+            }
+        }
+        eligible_file.close();
+    }
+
+private:
+    // WordleSolver is responsible for reducing the eligible words
+    friend class WordleSolver;
+
+    // Dictionary the ids refer to, nullptr when file-backed
+    const Dictionary *dictionary;
+
+    // Ids of the eligible words in increasing order
+    std::vector<uint32_t> ids;
+
+    // codes[i] and masks[i] are the packed code and letter mask of word ids[i],
+    // kept alongside the ids so filtering can stream over contiguous arrays
+    std::vector<uint32_t> codes;
+    std::vector<uint32_t> masks;
+
+    // Path to eligible words file, empty when in memory
+    std::string eligible_fp;
+
+    // Statistics of the words, computed by GetStatistics (nullptr until then)
+    mutable std::shared_ptr<const EligibleStatistics> statistics;
+
+    // Drops the statistics, must be called whenever the words change
+    void InvalidateStatistics();
+
+    /*
+    Updates the statistics after in-memory words were removed.
+
+    If statistics were computed and fewer words were removed than kept, the
+    statistics are derived by removing the removed words from a copy of them
+    (they may be shared). Otherwise they are dropped and recomputed from the
+    kept words when next asked for.
+
+    Parameters:
+        prev_ids: Ids of the words before the removal (ids must be a subsequence).
+        prev_codes: Codes of the words before the removal.
+        prev_masks: Letter masks of the words before the removal.
+    */
+    void UpdateStatistics(const std::vector<uint32_t> &prev_ids, const std::vector<uint32_t> &prev_codes, const std::vector<uint32_t> &prev_masks);
+};
+
+#endif
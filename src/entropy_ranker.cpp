@@ -0,0 +1,44 @@
+// Implementation of entropy_ranker.h
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "entropy_ranker.h"
+#include <cmath>
+#include <string>
+
+EntropyRanker::EntropyRanker() : EntropyRanker("EntropyRanker()", 0, false) {}
+EntropyRanker::EntropyRanker(size_t num_threads, bool early_cutoff) : EntropyRanker("EntropyRanker(" + std::to_string(early_cutoff) + ")", num_threads, early_cutoff) {}
+EntropyRanker::EntropyRanker(std::string_view name, size_t num_threads, bool early_cutoff) : EntropyRanker(name, nullptr, num_threads, early_cutoff) {}
+EntropyRanker::EntropyRanker(std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff) : EntropyRanker("EntropyRanker(FeedbackMatrix," + std::to_string(early_cutoff) + ")", m, num_threads, early_cutoff) {}
+EntropyRanker::EntropyRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff) : PartitionRanker(name, m, num_threads, early_cutoff) {}
+
+void EntropyRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
+{
+    PartitionRanker::SetUp(eligible, guess, feedback);
+
+    xlogx.resize(GetNumAnswers() + 1);
+    xlogx[0] = 0;
+    for (size_t c{1}; c < xlogx.size(); c++)
+    {
+        xlogx[c] = c * std::log2(static_cast<double>(c));
+    }
+}
+
+std::unique_ptr<AbstractRanker> EntropyRanker::Clone() const
+{
+    return std::make_unique<EntropyRanker>(*this);
+}
+
+int EntropyRanker::PartitionRank(const uint32_t (&sizes)[NUM_FEEDBACK_CODES]) const
+{
+    // The entropy is log2(n) - sum(c * log2(c)) / n, the sum only grows as a
+    // group grows so the rank does too
+    double sum{0};
+    for (auto c : sizes)
+    {
+        sum += xlogx[c];
+    }
+    auto n{static_cast<double>(GetNumAnswers())};
+    auto entropy{n == 0 ? 0 : std::log2(n) - sum / n};
+    return -static_cast<int>(std::lround(entropy * RANK_SCALE));
+}
@@ -0,0 +1,109 @@
+/*
+Header for EntropyRanker.
+
+This file defines the EntropyRanker class which ranks guesses by how much
+information their feedback is expected to give about the solution.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef ENTROPY_RANKER_H
+#define ENTROPY_RANKER_H
+
+#include "partition_ranker.h"
+
+/*
+Class that ranks words by the entropy of the feedback they would receive.
+
+Every eligible word is treated as an equally likely solution. The Shannon
+entropy of the sizes of the groups a guess splits the eligible words into
+(see PartitionRanker) is the expected number of bits of information the
+guess gives, so guesses that split the eligible words most evenly rank best.
+Unlike the frequency based rankers, this directly measures how well a guess
+narrows down the eligible words.
+*/
+class EntropyRanker : public PartitionRanker
+{
+public:
+    /*
+    Constructs an EntropyRanker that uses every hardware thread without early cutoff.
+    */
+    EntropyRanker();
+
+    /*
+    Constructs an EntropyRanker.
+
+    Parameters:
+        num_threads: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        early_cutoff: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+    */
+    EntropyRanker(size_t num_threads, bool early_cutoff);
+
+    /*
+    Overloaded version of EntropyRanker(size_t,bool) that allows name specification.
+
+    Parameters:
+        name: Name for the ranker
+        num_threads: See EntropyRanker(size_t,bool).
+        early_cutoff: See EntropyRanker(size_t,bool).
+    */
+    EntropyRanker(std::string_view name, size_t num_threads, bool early_cutoff);
+
+    /*
+    Overloaded version of EntropyRanker(size_t,bool) that looks feedback up in a FeedbackMatrix.
+
+    Parameters:
+        m: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        num_threads: See EntropyRanker(size_t,bool).
+        early_cutoff: See EntropyRanker(size_t,bool).
+    */
+    EntropyRanker(std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff);
+
+    /*
+    Overloaded version of EntropyRanker(std::shared_ptr<const FeedbackMatrix>,size_t,bool) that allows name specification.
+
+    Parameters:
+        name: Name for the ranker
+        m: See EntropyRanker(std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        num_threads: See EntropyRanker(size_t,bool).
+        early_cutoff: See EntropyRanker(size_t,bool).
+    */
+    EntropyRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff);
+
+    /*
+    Sets up an EntropyRanker to rank based on the currently eligible words.
+
+    Besides PartitionRanker::SetUp, this tabulates c * log2(c) for every group
+    size c that can occur.
+
+    Parameters:
+        eligible: The remaining eligible words.
+        guess: What guess this set up will be for (1...6).
+        feedback: Feedback on previous guess (if guess = 1, this parameter should not
+                  be used by SetUp, it will be set to some placeholder when called).
+    */
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
+
+    // Returns a copy of this ranker with its own ThreadPool (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Multiplier applied to the entropy (in bits) to get an integer rank
+    static const int RANK_SCALE{1000000};
+
+protected:
+    /*
+    Ranks by the entropy of the group sizes.
+
+    Returns:
+        The entropy in bits times -RANK_SCALE rounded to an integer (so higher
+        entropy is a lower rank).
+    */
+    virtual int PartitionRank(const uint32_t (&sizes)[NUM_FEEDBACK_CODES]) const override;
+
+private:
+    // xlogx[c] is c * log2(c) for c = 0...number of eligible words
+    std::vector<double> xlogx;
+};
+
+#endif
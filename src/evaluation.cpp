@@ -3,7 +3,6 @@
 // Date: Summer 2022
 
 #include <string>
-#include <unordered_map>
 #include <iterator>
 #include "ranker.h"
 #include <vector>
@@ -14,78 +13,213 @@
 #include <fstream>
 #include <iomanip>
 #include "misc.h"
+#include "feedback.h"
+#include "thread_pool.h"
+#include "opening_book.h"
+#include "fingerprint_cache.h"
+#include "constraint.h"
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <optional>
+#include <limits>
 
 std::string GetFeedback(std::string_view guess, std::string_view word)
 {
-    // Feedback that will be returned
-    std::string feedback(5, 'b');
+    // The integer kernel does the work, see GetFeedbackCode for how green, yellow,
+    // and black letters are derived (including duplicate letters)
+    return DecodeFeedback(GetFeedbackCode(EncodeWord(guess), EncodeWord(word)));
+}
 
-    // Count of each letter in word that is missing from guess
-    std::unordered_map<char, int> counts;
+short Evaluate(WordleSolver &solver, std::string_view word)
+{
+    // Current guess, feedback code (word is packed once per game)
+    std::string guess;
+    uint8_t feedback_code{0};
+    auto word_code{EncodeWord(word)};
 
-    // Loop over word, calculate letter counts and derive green feedback
-    // characters (easier than yellow and black)
-    for (auto witr{word.cbegin()}; witr != word.cend(); witr++)
+    // num_guesses is the number of guesses made up to this point
+    for (auto num_guesses{0}; num_guesses < 6; num_guesses++)
     {
-        counts[*witr]++;
-        auto idx{std::distance(word.cbegin(), witr)};
-        if (guess[idx] == *witr)
+        // 0 guesses have been made previously, make initial guess, otherwise
+        // use feedback from previous guess
+        guess = (num_guesses == 0) ? solver.Guess() : solver.Guess(DecodeFeedback(feedback_code));
+        feedback_code = GetFeedbackCode(EncodeWord(guess), word_code);
+        if (feedback_code == ALL_GREEN_CODE)
         {
-            feedback[idx] = 'g';
-            // Guess has found letter at idx
-            counts[*witr]--;
+            return num_guesses;
         }
     }
+    return FAILED;
+}
+
+short Evaluate(WordleSolver &solver, std::string_view word, const FeedbackMatrix &matrix)
+{
+    std::string guess;
+    uint8_t feedback_code{0};
 
-    // Pass over guess to identify yellow and black letters
-    for (auto gitr{guess.cbegin()}; gitr != guess.cend(); gitr++)
+    for (auto num_guesses{0}; num_guesses < 6; num_guesses++)
     {
-        auto idx{std::distance(guess.cbegin(), gitr)};
-        // If current guess character is not equal to word[idx] but
-        // there is an instance of it that has not been found elsewhere
-        // in word, mark feedback yellow and decrement that current
-        // guess character accounts for one of missing instances of
-        // it in the word - this ensures that if we duplicate a needed
-        // letter, it won't mark them both yellow. Example: guess "erect"
-        // for solution "runes". We want the feedback to be yybbb.
-        if (*gitr != word[idx] && counts[*gitr] > 0)
+        guess = (num_guesses == 0) ? solver.Guess() : solver.Guess(DecodeFeedback(feedback_code));
+        feedback_code = matrix.Get(guess, word);
+        if (feedback_code == ALL_GREEN_CODE)
         {
-            counts[*gitr]--;
-            feedback[idx] = 'y';
+            return num_guesses;
         }
-        // If guess character is equal to word[idx], don't do anything
-        // because feedback[idx] should remain green. If the guess
-        // character is != to word[idx] but the count is 0, leave
-        // feedback[idx] black. This ensures that the following examples
-        // are treated properly: guess "again" for word "bland" has feedback
-        // "bbgby", guess "aroma" for word "bland" has feedback "ybbbb",
-        // guess "again" for word "aroma" has feedback "gbybb".
     }
-
-    return feedback;
+    return FAILED;
 }
 
-short Evaluate(WordleSolver &solver, std::string_view word)
+short Evaluate(StrategySolver &solver, std::string_view word)
 {
-    // Current guess, feedback
     std::string guess;
-    std::string feedback;
+    uint8_t feedback_code{0};
+    auto word_code{EncodeWord(word)};
 
-    // num_guesses is the number of guesses made up to this point
-    for (auto num_guesses{0}; num_guesses < 6; num_guesses++)
+    try
     {
-        // 0 guesses have been made previously, make initial guess, otherwise
-        // use feedback from previous guess
-        guess = (num_guesses == 0) ? solver.Guess() : solver.Guess(feedback);
-        feedback = GetFeedback(guess, word);
-        if (feedback == "ggggg")
+        for (auto num_guesses{0}; num_guesses < 6; num_guesses++)
         {
-            return num_guesses;
+            guess = (num_guesses == 0) ? solver.Guess() : solver.Guess(DecodeFeedback(feedback_code));
+            feedback_code = GetFeedbackCode(EncodeWord(guess), word_code);
+            if (feedback_code == ALL_GREEN_CODE)
+            {
+                return num_guesses;
+            }
         }
     }
+    catch (const WordleSolverException &e)
+    {
+        // The strategy has no guess after the feedback (word is not in its dictionary)
+    }
     return FAILED;
 }
 
+// Plays the words in targets, which share the feedback of the previous guesses,
+// given the solver has just made its guess number num_guesses + 1 (guess) in their
+// game. Stores their guess counts. The feedback for word idx is computed or, if
+// matrix is not null, looked up.
+static void EvaluateGroup(WordleSolver &solver, const std::string &guess, short num_guesses, const std::vector<size_t> &targets, const std::vector<std::string> &words, const std::vector<uint32_t> &word_codes, const FeedbackMatrix *matrix, std::vector<short> &guess_counts)
+{
+    // Split the targets by the feedback they give guess
+    std::vector<size_t> groups[NUM_FEEDBACK_CODES];
+    size_t num_groups{0};
+    auto guess_code{EncodeWord(guess)};
+    for (auto idx : targets)
+    {
+        auto feedback_code{matrix ? matrix->Get(guess, words[idx]) : GetFeedbackCode(guess_code, word_codes[idx])};
+        if (feedback_code == ALL_GREEN_CODE)
+        {
+            guess_counts[idx] = num_guesses;
+        }
+        else
+        {
+            num_groups += groups[feedback_code].empty();
+            groups[feedback_code].push_back(idx);
+        }
+    }
+
+    // 6 guesses have been made, the rest have failed
+    if (num_guesses + 1 == 6)
+    {
+        for (const auto &group : groups)
+        {
+            for (auto idx : group)
+            {
+                guess_counts[idx] = FAILED;
+            }
+        }
+        return;
+    }
+
+    // The first group goes on from guess, the game is restored to guess for the others
+    std::optional<WordleSolver::GameState> at_guess;
+    if (num_groups > 1)
+    {
+        at_guess = solver.SaveGame();
+    }
+    auto first_group{true};
+    for (size_t c{0}; c < NUM_FEEDBACK_CODES; c++)
+    {
+        if (groups[c].empty())
+        {
+            continue;
+        }
+        if (!first_group)
+        {
+            solver.RestoreGame(*at_guess);
+        }
+        first_group = false;
+
+        auto next_guess{solver.Guess(DecodeFeedback(static_cast<uint8_t>(c)))};
+        EvaluateGroup(solver, next_guess, num_guesses + 1, groups[c], words, word_codes, matrix, guess_counts);
+    }
+}
+
+// Encodes the words for EvaluateGroup (only needed without a matrix)
+static std::vector<uint32_t> EncodeWords(const std::vector<std::string> &words, const FeedbackMatrix *matrix)
+{
+    std::vector<uint32_t> word_codes;
+    if (!matrix)
+    {
+        word_codes.reserve(words.size());
+        for (const auto &word : words)
+        {
+            word_codes.push_back(EncodeWord(word));
+        }
+    }
+    return word_codes;
+}
+
+// Plays the words in targets, which all give feedback code first_code on the
+// solver's initial guess, storing their guess counts. The groups of the first
+// guess are independent, so they can be played by separate solvers.
+static void EvaluateFirstGroup(WordleSolver &solver, uint8_t first_code, const std::vector<size_t> &targets, const std::vector<std::string> &words, const std::vector<uint32_t> &word_codes, const FeedbackMatrix *matrix, std::vector<short> &guess_counts)
+{
+    solver.Guess();
+    if (first_code == ALL_GREEN_CODE)
+    {
+        for (auto idx : targets)
+        {
+            guess_counts[idx] = 0;
+        }
+        return;
+    }
+    auto next_guess{solver.Guess(DecodeFeedback(first_code))};
+    EvaluateGroup(solver, next_guess, 1, targets, words, word_codes, matrix, guess_counts);
+}
+
+// Plays every word starting with the solver's initial guess
+static std::vector<short> EvaluateAll(WordleSolver &solver, const std::vector<std::string> &words, const FeedbackMatrix *matrix)
+{
+    std::vector<short> guess_counts(words.size(), FAILED);
+    if (words.empty())
+    {
+        return guess_counts;
+    }
+
+    auto word_codes{EncodeWords(words, matrix)};
+    std::vector<size_t> targets(words.size());
+    std::iota(targets.begin(), targets.end(), 0);
+    EvaluateGroup(solver, solver.Guess(), 0, targets, words, word_codes, matrix, guess_counts);
+    return guess_counts;
+}
+
+std::vector<short> EvaluateAll(WordleSolver &solver, const std::vector<std::string> &words)
+{
+    return EvaluateAll(solver, words, nullptr);
+}
+
+std::vector<short> EvaluateAll(WordleSolver &solver, const std::vector<std::string> &words, const FeedbackMatrix &matrix)
+{
+    return EvaluateAll(solver, words, &matrix);
+}
+
 void GetStatistics(const std::vector<short> &guess_counts, double &mean, double &std_dev, size_t &fail_count)
 {
     // Set fail count to 0 in case user passes something else
@@ -122,6 +256,37 @@ void GetStatistics(const std::vector<short> &guess_counts, double &mean, double
 }
 
 void GridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp)
+{
+    GridEvaluate(dictionary_fps, rankers, words_fp, false);
+}
+
+void GridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp, bool use_feedback_matrix)
+{
+    GridEvaluate(dictionary_fps, rankers, words_fp, use_feedback_matrix, 0);
+}
+
+// Reports the guess counts of one (dictionary, ranker) cell of GridEvaluate: prints
+// failed words, writes the statistics row to output_file and prints progress
+static void WriteCell(std::ofstream &output_file, const std::string &dictionary_fp, const AbstractRanker *ranker, const std::vector<std::string> &words, const std::vector<short> &guess_counts)
+{
+    for (size_t idx{0}; idx < words.size(); idx++)
+    {
+        if (guess_counts[idx] == FAILED)
+        {
+            std::cout << "Dictionary [" << dictionary_fp << "] Ranker [" << ranker->GetName() << "] failed to guess [" << words[idx] << "]" << std::endl;
+        }
+    }
+
+    // Compute statistics and write to output file
+    double mean{0};
+    double std_dev{0};
+    size_t fail_count{0};
+    GetStatistics(guess_counts, mean, std_dev, fail_count);
+    output_file << dictionary_fp << "\t" << ranker->GetName() << "\t" << mean << "\t" << std_dev << "\t" << (100.0 * fail_count) / words.size() << std::endl;
+    std::cout << "Finished Evaluation of Dictionary [" << dictionary_fp << "] Ranker [" << ranker->GetName() << "]" << std::endl;
+}
+
+void GridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp, bool use_feedback_matrix, size_t num_threads)
 {
     // Read-only file stream to words
     std::ifstream words_file(words_fp, std::ios_base::in);
@@ -153,36 +318,558 @@ void GridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vec
     // 6 decimals shown with all output (including integers stored in floats)
     output_file << std::fixed;
 
-    std::vector<short> guess_counts(words.size());
-    double mean{0};
-    double std_dev{0};
-    size_t fail_count{0};
+    // Dictionaries (and their feedback matrices) are loaded once and shared by the solvers
+    std::vector<std::shared_ptr<const Dictionary>> dictionaries;
+    std::vector<std::shared_ptr<const FeedbackMatrix>> matrices;
+    for (const auto &dfp : dictionary_fps)
+    {
+        dictionaries.push_back(std::make_shared<const Dictionary>(dfp));
+        matrices.push_back(use_feedback_matrix ? std::make_shared<const FeedbackMatrix>(dictionaries.back(), FeedbackMatrix::GetDefaultFilePath(dfp)) : nullptr);
+    }
+
+    // Openings are ranked once per (dictionary, ranker) and shared by every solver,
+    // as are the statistics of eligible words reached by more than one solver
+    auto book{std::make_shared<OpeningBook>()};
+    const size_t STATISTICS_CACHE_CAPACITY{256};
+    auto statistics_cache{std::make_shared<FingerprintCache<EligibleStatistics>>(STATISTICS_CACHE_CAPACITY)};
 
-    // Iterate over dictionaries, ranking schemes and construct a WordleSolver for each
-    for (auto dfp_itr{dictionary_fps.cbegin()}; dfp_itr != dictionary_fps.cend(); dfp_itr++)
+    // Evaluates a solver on words [begin, end) storing the guess counts
+    auto evaluate_words{[&words, &matrices](WordleSolver &solver, size_t d, std::vector<short> &guess_counts, size_t begin, size_t end)
+                        {
+                            for (auto idx{begin}; idx < end; idx++)
+                            {
+                                guess_counts[idx] = matrices[d] ? Evaluate(solver, words[idx], *matrices[d]) : Evaluate(solver, words[idx]);
+                            }
+                        }};
+
+    // Evaluates a solver with a deterministic ranker on all words at once
+    auto evaluate_all_words{[&words, &matrices](WordleSolver &solver, size_t d, std::vector<short> &guess_counts)
+                            {
+                                guess_counts = matrices[d] ? EvaluateAll(solver, words, *matrices[d]) : EvaluateAll(solver, words);
+                            }};
+
+    if (num_threads == 1)
     {
-        for (auto rkr_itr{rankers.cbegin()}; rkr_itr != rankers.cend(); rkr_itr++)
+        // Serial path: iterate over dictionaries, ranking schemes and construct a
+        // WordleSolver for each that uses the passed ranker directly
+        std::vector<short> guess_counts(words.size());
+        for (size_t d{0}; d < dictionaries.size(); d++)
         {
-            WordleSolver solver(*dfp_itr, *rkr_itr);
-
-            // With constructed solver, iterate over words and get guess count for
-            // that word with Evaluate()
-            for (auto w_itr{words.cbegin()}; w_itr != words.cend(); w_itr++)
+            for (auto rkr_itr{rankers.cbegin()}; rkr_itr != rankers.cend(); rkr_itr++)
             {
-                auto idx{std::distance(words.cbegin(), w_itr)};
-                guess_counts[idx] = Evaluate(solver, *w_itr);
-                if (guess_counts[idx] == FAILED)
+                WordleSolver solver(dictionaries[d], *rkr_itr, false);
+                solver.SetOpeningBook(book);
+                solver.SetStatisticsCache(statistics_cache);
+                if (matrices[d])
+                {
+                    solver.SetFeedbackMatrix(matrices[d]);
+                }
+                if ((*rkr_itr)->IsDeterministic())
                 {
-                    std::cout << "Dictionary [" << *dfp_itr << "] Ranker [" << (*rkr_itr)->GetName() << "] failed to guess [" << *w_itr << "]" << std::endl;
+                    evaluate_all_words(solver, d, guess_counts);
                 }
+                else
+                {
+                    evaluate_words(solver, d, guess_counts, 0, words.size());
+                }
+                WriteCell(output_file, dictionary_fps[d], *rkr_itr, words, guess_counts);
             }
+        }
+        output_file.close();
+        std::cout << "Statistics cache: " << statistics_cache->GetHits() << " hits, " << statistics_cache->GetMisses() << " misses" << std::endl;
+        std::cout << "GridEvaluation Complete" << std::endl;
+        return;
+    }
 
-            // Compute statistics and write to output file
-            GetStatistics(guess_counts, mean, std_dev, fail_count);
-            output_file << *dfp_itr << "\t" << (*rkr_itr)->GetName() << "\t" << mean << "\t" << std_dev << "\t" << (100.0 * fail_count) / words.size() << std::endl;
-            std::cout << "Finished Evaluation of Dictionary [" << *dfp_itr << "] Ranker [" << (*rkr_itr)->GetName() << "]" << std::endl;
+    // Parallel path: each cell (dictionary, ranker) is split into tasks that are
+    // run on a work-stealing pool. A cell with a non-deterministic ranker is split
+    // into chunks of words. A cell with a deterministic ranker starts with one task
+    // that makes the first guess, which then submits a task per group of words
+    // giving the same feedback on it, so the games in a group share guesses and
+    // the groups use the whole pool. A worker uses its own clone of the cell's
+    // ranker so no ranker is used by two threads at once.
+    ThreadPool pool(num_threads);
+    const size_t CHUNK_SIZE{8};
+    auto num_cells{dictionaries.size() * rankers.size()};
+    std::vector<std::vector<short>> cell_counts(num_cells, std::vector<short>(words.size()));
+    std::vector<std::vector<uint32_t>> word_codes;
+    for (size_t d{0}; d < dictionaries.size(); d++)
+    {
+        word_codes.push_back(EncodeWords(words, matrices[d].get()));
+    }
+
+    // Solver of the cell a worker most recently worked on, reused while the worker
+    // keeps getting tasks of the same cell
+    struct WorkerState
+    {
+        size_t cell{SIZE_MAX};
+        std::unique_ptr<AbstractRanker> ranker;
+        std::unique_ptr<WordleSolver> solver;
+    };
+    std::vector<WorkerState> states(pool.Size());
+    auto get_solver{[&](size_t worker, size_t cell) -> WordleSolver &
+                    {
+                        auto d{cell / rankers.size()};
+                        auto &state{states[worker]};
+                        if (state.cell != cell)
+                        {
+                            state.solver.reset();
+                            state.ranker = rankers[cell % rankers.size()]->Clone();
+                            state.solver = std::make_unique<WordleSolver>(dictionaries[d], state.ranker.get(), false);
+
+                            // The second guesses are ranked by the tasks of the groups
+                            // that need them rather than all by the first task
+                            state.solver->SetOpeningBook(book, true);
+                            state.solver->SetStatisticsCache(statistics_cache);
+                            if (matrices[d])
+                            {
+                                state.solver->SetFeedbackMatrix(matrices[d]);
+                            }
+                            state.cell = cell;
+                        }
+                        return *state.solver;
+                    }};
+
+    // Cells are written in the same order as the serial path as soon as they and
+    // all cells before them have finished (tasks_left counts the unfinished tasks
+    // of a cell, including ones that are yet to be submitted by a cell's first task)
+    std::vector<size_t> tasks_left(num_cells);
+    size_t next_cell_to_write{0};
+    std::mutex write_mutex;
+    auto write_finished_cells{[&]()
+                              {
+                                  while (next_cell_to_write < num_cells && tasks_left[next_cell_to_write] == 0)
+                                  {
+                                      auto d{next_cell_to_write / rankers.size()};
+                                      auto r{next_cell_to_write % rankers.size()};
+                                      WriteCell(output_file, dictionary_fps[d], rankers[r], words, cell_counts[next_cell_to_write]);
+                                      next_cell_to_write++;
+                                  }
+                              }};
+    auto finish_task{[&](size_t cell)
+                     {
+                         std::lock_guard<std::mutex> lock(write_mutex);
+                         tasks_left[cell]--;
+                         write_finished_cells();
+                     }};
+
+    for (size_t cell{0}; cell < num_cells; cell++)
+    {
+        if (!rankers[cell % rankers.size()]->IsDeterministic())
+        {
+            tasks_left[cell] = (words.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+            for (size_t begin{0}; begin < words.size(); begin += CHUNK_SIZE)
+            {
+                pool.Submit([&, cell, begin](size_t worker)
+                            {
+                    evaluate_words(get_solver(worker, cell), cell / rankers.size(), cell_counts[cell], begin, std::min(begin + CHUNK_SIZE, words.size()));
+                    finish_task(cell); });
+            }
+            continue;
         }
+
+        tasks_left[cell] = 1;
+        pool.Submit([&, cell](size_t worker)
+                    {
+            auto d{cell / rankers.size()};
+            const auto *matrix{matrices[d].get()};
+            auto first_guess{get_solver(worker, cell).Guess()};
+
+            // Split the words by the feedback they give the first guess
+            std::vector<size_t> groups[NUM_FEEDBACK_CODES];
+            auto first_code{EncodeWord(first_guess)};
+            for (size_t idx{0}; idx < words.size(); idx++)
+            {
+                groups[matrix ? matrix->Get(first_guess, words[idx]) : GetFeedbackCode(first_code, word_codes[d][idx])].push_back(idx);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(write_mutex);
+                for (const auto &group : groups)
+                {
+                    tasks_left[cell] += !group.empty();
+                }
+            }
+            for (size_t c{0}; c < NUM_FEEDBACK_CODES; c++)
+            {
+                if (groups[c].empty())
+                {
+                    continue;
+                }
+                pool.Submit([&, cell, d, matrix, c, group = std::move(groups[c])](size_t worker)
+                            {
+                    EvaluateFirstGroup(get_solver(worker, cell), static_cast<uint8_t>(c), group, words, word_codes[d], matrix, cell_counts[cell]);
+                    finish_task(cell); });
+            }
+            finish_task(cell); });
     }
+    pool.Wait();
+
+    // Only reached with no cells if there are no words
+    write_finished_cells();
     output_file.close();
+    std::cout << "Statistics cache: " << statistics_cache->GetHits() << " hits, " << statistics_cache->GetMisses() << " misses" << std::endl;
     std::cout << "GridEvaluation Complete" << std::endl;
-}
\ No newline at end of file
+}
+
+void BenchmarkGridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp)
+{
+    auto output_fp{InsertFilePathSuffix(words_fp, OUTPUT_SUFFIX)};
+
+    // Runs GridEvaluate with num_threads threads, returns the time taken and
+    // stores what was written to the output file in output
+    auto run{[&](size_t num_threads, std::string &output)
+             {
+                 auto start{std::chrono::steady_clock::now()};
+                 GridEvaluate(dictionary_fps, rankers, words_fp, false, num_threads);
+                 std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+                 std::ifstream output_file(output_fp, std::ios_base::in);
+                 if (!output_file.is_open())
+                 {
+                     throw WordleSolverException("Could not open output file to read");
+                 }
+                 std::ostringstream oss;
+                 oss << output_file.rdbuf();
+                 output = oss.str();
+                 return elapsed.count();
+             }};
+
+    std::string serial_output;
+    std::string parallel_output;
+    auto serial_time{run(1, serial_output)};
+    auto parallel_time{run(0, parallel_output)};
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Serial GridEvaluate: " << serial_time << "s" << std::endl;
+    std::cout << "Parallel GridEvaluate (" << std::max(1u, std::thread::hardware_concurrency()) << " threads): " << parallel_time << "s" << std::endl;
+    std::cout << "Speedup: " << serial_time / parallel_time << "x" << std::endl;
+    std::cout << "Outputs " << ((serial_output == parallel_output) ? "match" : "DIFFER") << std::endl;
+}
+
+void BenchmarkGuessLatency(const std::string &dictionary_fp, AbstractRanker *ranker, const std::string &words_fp)
+{
+    std::ifstream words_file(words_fp, std::ios_base::in);
+    if (!words_file.is_open())
+    {
+        throw WordleSolverException("Could not open words file to read");
+    }
+    std::vector<std::string> words;
+    std::string current_line;
+    while (words_file.good())
+    {
+        std::getline(words_file, current_line);
+        words.push_back(current_line);
+    }
+    words_file.close();
+
+    auto dictionary{std::make_shared<const Dictionary>(dictionary_fp)};
+    std::cout << std::fixed << std::setprecision(3);
+    for (auto hard_mode : {true, false})
+    {
+        WordleSolver solver(dictionary, ranker, false);
+        solver.SetHardMode(hard_mode);
+
+        // Times of the first guesses and of the later guesses (in ms)
+        std::vector<double> latencies[2];
+        std::vector<short> guess_counts;
+        for (const auto &word : words)
+        {
+            // Same as Evaluate with each guess timed
+            auto word_code{EncodeWord(word)};
+            uint8_t feedback_code{0};
+            short guess_count{FAILED};
+            for (auto num_guesses{0}; num_guesses < 6; num_guesses++)
+            {
+                auto start{std::chrono::steady_clock::now()};
+                auto guess{(num_guesses == 0) ? solver.Guess() : solver.Guess(DecodeFeedback(feedback_code))};
+                std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+                latencies[num_guesses == 0 ? 0 : 1].push_back(elapsed.count());
+
+                feedback_code = GetFeedbackCode(EncodeWord(guess), word_code);
+                if (feedback_code == ALL_GREEN_CODE)
+                {
+                    guess_count = num_guesses;
+                    break;
+                }
+            }
+            guess_counts.push_back(guess_count);
+        }
+
+        double mean;
+        double std_dev;
+        size_t fail_count;
+        GetStatistics(guess_counts, mean, std_dev, fail_count);
+        std::cout << (hard_mode ? "Hard mode" : "Normal mode") << ": mean " << mean << " failures " << fail_count << std::endl;
+
+        const std::string labels[2]{"first guess", "later guesses"};
+        for (size_t l{0}; l < 2; l++)
+        {
+            if (latencies[l].empty())
+            {
+                continue;
+            }
+            auto total{std::accumulate(latencies[l].cbegin(), latencies[l].cend(), 0.0)};
+            auto max{*std::max_element(latencies[l].cbegin(), latencies[l].cend())};
+            std::cout << "    " << labels[l] << ": mean " << total / latencies[l].size() << "ms max " << max << "ms (" << latencies[l].size() << " guesses)" << std::endl;
+        }
+    }
+}
+
+void BenchmarkStrategy(const std::string &dictionary_fp, AbstractRanker *ranker, const std::string &words_fp)
+{
+    std::ifstream words_file(words_fp, std::ios_base::in);
+    if (!words_file.is_open())
+    {
+        throw WordleSolverException("Could not open words file to read");
+    }
+    std::vector<std::string> words;
+    std::string current_line;
+    while (words_file.good())
+    {
+        std::getline(words_file, current_line);
+        words.push_back(current_line);
+    }
+    words_file.close();
+
+    auto dictionary{std::make_shared<const Dictionary>(dictionary_fp)};
+    auto strategy_fp{Strategy::GetDefaultFilePath(dictionary_fp)};
+    std::cout << std::fixed << std::setprecision(3);
+
+    // Times f in seconds
+    auto time{[](const auto &f)
+              {
+                  auto start{std::chrono::steady_clock::now()};
+                  f();
+                  std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+                  return elapsed.count();
+              }};
+
+    auto build_time{time([&]()
+                         { Strategy(dictionary, ranker, true, 0).Save(strategy_fp); })};
+    std::shared_ptr<const Strategy> strategy;
+    auto load_time{time([&]()
+                        { strategy = std::make_shared<const Strategy>(dictionary, strategy_fp); })};
+    std::cout << "Built strategy for " << strategy->GetRankerName() << " (" << strategy->Size() << " nodes) in " << build_time << "s, loaded in " << load_time << "s" << std::endl;
+
+    std::vector<short> strategy_counts(words.size());
+    auto strategy_time{time([&]()
+                            {
+                                StrategySolver solver(strategy);
+                                for (size_t i{0}; i < words.size(); i++)
+                                {
+                                    strategy_counts[i] = Evaluate(solver, words[i]);
+                                }
+                            })};
+
+    std::vector<short> solver_counts(words.size());
+    auto solver_time{time([&]()
+                          {
+                              WordleSolver solver(dictionary, ranker, false);
+                              for (size_t i{0}; i < words.size(); i++)
+                              {
+                                  solver_counts[i] = Evaluate(solver, words[i]);
+                              }
+                          })};
+
+    double mean;
+    double std_dev;
+    size_t fail_count;
+    GetStatistics(strategy_counts, mean, std_dev, fail_count);
+    std::cout << "StrategySolver: " << strategy_time << "s mean " << mean << " failures " << fail_count << std::endl;
+    GetStatistics(solver_counts, mean, std_dev, fail_count);
+    std::cout << "WordleSolver: " << solver_time << "s mean " << mean << " failures " << fail_count << std::endl;
+    std::cout << "Guess counts " << ((strategy_counts == solver_counts) ? "match" : "DIFFER") << std::endl;
+}
+
+void BenchmarkRankers(const std::string &dictionary_fp, AbstractRanker *ranker1, AbstractRanker *ranker2, const std::string &words_fp)
+{
+    std::ifstream words_file(words_fp, std::ios_base::in);
+    if (!words_file.is_open())
+    {
+        throw WordleSolverException("Could not open words file to read");
+    }
+    std::vector<std::string> words;
+    std::string current_line;
+    while (words_file.good())
+    {
+        std::getline(words_file, current_line);
+        words.push_back(current_line);
+    }
+    words_file.close();
+
+    auto dictionary{std::make_shared<const Dictionary>(dictionary_fp)};
+    EligibleWords eligible(dictionary.get());
+    std::vector<Word> dictionary_words;
+    std::vector<std::string> texts;
+    eligible.GetWords(dictionary_words, texts);
+    std::cout << std::fixed << std::setprecision(3);
+
+    // Times f in milliseconds, the fastest of a number of runs is used as it is
+    // the least disturbed by other work on the machine
+    const size_t NUM_RUNS{50};
+    auto time{[NUM_RUNS](const auto &f)
+              {
+                  auto fastest{std::numeric_limits<double>::max()};
+                  for (size_t run{0}; run < NUM_RUNS; run++)
+                  {
+                      auto start{std::chrono::steady_clock::now()};
+                      f();
+                      std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+                      fastest = std::min(fastest, elapsed.count());
+                  }
+                  return fastest;
+              }};
+
+    AbstractRanker *rankers[2]{ranker1, ranker2};
+    for (size_t r{0}; r < 2; r++)
+    {
+        std::cout << "Ranker " << r + 1 << ": " << rankers[r]->GetName() << std::endl;
+    }
+    for (std::string_view feedback : {"", "gybbg"})
+    {
+        std::vector<int> rank_all_ranks[2];
+        std::vector<int> rank_ranks[2];
+        for (size_t r{0}; r < 2; r++)
+        {
+            auto ranker{rankers[r]};
+            ranker->SetUp(eligible, feedback.empty() ? 1 : 2, feedback);
+            rank_all_ranks[r].resize(dictionary_words.size());
+            rank_ranks[r].resize(dictionary_words.size());
+            auto rank_all_time{time([&]()
+                                    { ranker->RankAll(dictionary_words, rank_all_ranks[r]); })};
+            auto rank_time{time([&]()
+                                {
+                                    for (size_t i{0}; i < dictionary_words.size(); i++)
+                                    {
+                                        rank_ranks[r][i] = ranker->Rank(dictionary_words[i].text);
+                                    }
+                                })};
+            std::cout << "Ranker " << r + 1 << " after feedback [" << feedback << "]: RankAll " << rank_all_time << "ms Rank " << rank_time << "ms" << std::endl;
+        }
+        auto ranks_match{rank_all_ranks[0] == rank_all_ranks[1] && rank_ranks[0] == rank_ranks[1] && rank_all_ranks[0] == rank_ranks[0]};
+        std::cout << "Ranks " << (ranks_match ? "match" : "DIFFER") << std::endl;
+    }
+
+    std::vector<short> guess_counts[2];
+    for (size_t r{0}; r < 2; r++)
+    {
+        WordleSolver solver(dictionary, rankers[r], false);
+        auto start{std::chrono::steady_clock::now()};
+        for (const auto &word : words)
+        {
+            guess_counts[r].push_back(Evaluate(solver, word));
+        }
+        std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+        double mean;
+        double std_dev;
+        size_t fail_count;
+        GetStatistics(guess_counts[r], mean, std_dev, fail_count);
+        std::cout << "Ranker " << r + 1 << ": " << elapsed.count() << "s mean " << mean << " failures " << fail_count << std::endl;
+    }
+    std::cout << "Guess counts " << ((guess_counts[0] == guess_counts[1]) ? "match" : "DIFFER") << std::endl;
+}
+
+void BenchmarkConstraintKernels(const std::string &dictionary_fp, const std::string &words_fp)
+{
+    std::ifstream words_file(words_fp, std::ios_base::in);
+    if (!words_file.is_open())
+    {
+        throw WordleSolverException("Could not open words file to read");
+    }
+    std::vector<std::string> words;
+    std::vector<uint32_t> word_codes;
+    std::string current_line;
+    while (words_file.good())
+    {
+        std::getline(words_file, current_line);
+        if (IsWord(current_line))
+        {
+            words.push_back(current_line);
+            word_codes.push_back(EncodeWord(current_line));
+        }
+    }
+    words_file.close();
+
+    Dictionary dictionary(dictionary_fp);
+    auto codes{dictionary.GetCodes()};
+    auto masks{dictionary.GetMasks()};
+    std::cout << std::fixed << std::setprecision(3);
+
+    const std::pair<FeedbackConstraint::Kernel, const char *> KERNELS[]{{FeedbackConstraint::Kernel::Scalar, "Scalar"},
+                                                                         {FeedbackConstraint::Kernel::Sse2, "SSE2"},
+                                                                         {FeedbackConstraint::Kernel::Avx2, "AVX2"}};
+    double kernel_times[std::size(KERNELS)]{};
+    bool kernels_match[std::size(KERNELS)];
+    std::fill(std::begin(kernels_match), std::end(kernels_match), true);
+    size_t num_constraints{0};
+
+    std::vector<uint8_t> row(dictionary.Size());
+    std::vector<uint32_t> expected_ids;
+    std::vector<uint32_t> ids(dictionary.Size());
+    std::vector<uint32_t> filter_codes(dictionary.Size());
+    std::vector<uint32_t> filter_masks(dictionary.Size());
+    for (size_t g{0}; g < words.size(); g++)
+    {
+        auto guess_code{word_codes[g]};
+        // The feedback the guess gets against each dictionary word, which the
+        // kept words are checked against
+        for (uint32_t id{0}; id < dictionary.Size(); id++)
+        {
+            row[id] = GetFeedbackCode(guess_code, codes[id]);
+        }
+
+        bool seen[NUM_FEEDBACK_CODES]{};
+        for (auto word_code : word_codes)
+        {
+            auto feedback_code{GetFeedbackCode(guess_code, word_code)};
+            if (seen[feedback_code])
+            {
+                continue;
+            }
+            seen[feedback_code] = true;
+            num_constraints++;
+
+            expected_ids.clear();
+            for (uint32_t id{0}; id < dictionary.Size(); id++)
+            {
+                if (row[id] == feedback_code)
+                {
+                    expected_ids.push_back(id);
+                }
+            }
+
+            FeedbackConstraint constraint(words[g], DecodeFeedback(feedback_code));
+            for (size_t k{0}; k < std::size(KERNELS); k++)
+            {
+                if (!FeedbackConstraint::IsSupported(KERNELS[k].first))
+                {
+                    continue;
+                }
+                std::iota(ids.begin(), ids.end(), 0);
+                std::copy(codes.begin(), codes.end(), filter_codes.begin());
+                std::copy(masks.begin(), masks.end(), filter_masks.begin());
+                auto start{std::chrono::steady_clock::now()};
+                auto kept{constraint.Filter(ids.data(), filter_codes.data(), filter_masks.data(), ids.size(), KERNELS[k].first)};
+                std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+                kernel_times[k] += elapsed.count();
+                kernels_match[k] = kernels_match[k] && std::equal(ids.begin(), ids.begin() + kept, expected_ids.begin(), expected_ids.end());
+            }
+        }
+    }
+
+    std::cout << "Checked " << num_constraints << " constraints on " << dictionary.Size() << " words" << std::endl;
+    auto all_match{true};
+    for (size_t k{0}; k < std::size(KERNELS); k++)
+    {
+        if (!FeedbackConstraint::IsSupported(KERNELS[k].first))
+        {
+            std::cout << KERNELS[k].second << ": not supported" << std::endl;
+            continue;
+        }
+        std::cout << KERNELS[k].second << ": " << kernel_times[k] << "ms " << (kernels_match[k] ? "match" : "DIFFER") << std::endl;
+        all_match = all_match && kernels_match[k];
+    }
+    std::cout << "Kernels " << (all_match ? "match" : "DIFFER") << std::endl;
+}
@@ -16,6 +16,9 @@ Date: Summer 2022
 #include <vector>
 #include "solver.h"
 #include "ranker.h"
+#include "feedback_matrix.h"
+#include "feedback.h"
+#include "strategy.h"
 
 // Constant to indicate Evaluate() failed
 const short FAILED{-1};
@@ -26,9 +29,12 @@ const std::string OUTPUT_SUFFIX{"-output"};
 /*
 Derives the Wordle feedback for a guess for a particular word.
 
+This is a thin wrapper that decodes GetFeedbackCode (see feedback.h), use
+that directly on packed words in hot loops.
+
 Parameters:
-    guess: A guess. Assumed to be a 5-letter word.
-    word: A word. Also assumed to be 5 letters.
+    guess: A guess. Assumed to be a 5-letter lowercase word.
+    word: A word. Also assumed to be 5 lowercase letters.
 
 Returns:
     The feedback represented as a string of g, b, and y. g represents
@@ -50,6 +56,73 @@ Returns:
 */
 short Evaluate(WordleSolver &solver, std::string_view word);
 
+/*
+Overloaded version of Evaluate that looks up feedback in a FeedbackMatrix.
+
+Parameters:
+    solver: A WordleSolver.
+    word: A 5-letter word.
+    matrix: Precomputed feedback for the solver's dictionary. Feedback for a
+    guess or word that is not in the dictionary is computed.
+
+Returns:
+    Number of guesses it takes solver to guess word. If the solver fails
+    to do so, FAILED is returned.
+*/
+short Evaluate(WordleSolver &solver, std::string_view word, const FeedbackMatrix &matrix);
+
+/*
+Overloaded version of Evaluate for a StrategySolver.
+
+Parameters:
+    solver: A StrategySolver.
+    word: A 5-letter word.
+
+Returns:
+    Number of guesses it takes solver to guess word. If the solver fails
+    to do so (including if the strategy has no guess for some feedback),
+    FAILED is returned.
+*/
+short Evaluate(StrategySolver &solver, std::string_view word);
+
+/*
+Evaluates a WordleSolver on guessing every word in a list.
+
+The words are played together instead of one at a time: after each guess they
+are split into groups by the feedback they give it, and each group is played on
+from there. So the solver makes one guess per distinct history of feedback
+rather than one per word (every word shares the first guess, many share the next
+few). After a guess the solver goes on with one group, and the game is restored
+to that guess for each other group (see WordleSolver::SaveGame). With a deterministic ranker (see
+AbstractRanker::IsDeterministic) the guess counts are the same as calling
+Evaluate() on each word.
+
+Parameters:
+    solver: An in-memory WordleSolver with a deterministic ranker.
+    words: 5-letter words.
+
+Returns:
+    Guess counts (as returned by Evaluate()) in the same order as words.
+
+Throws:
+    WordleSolverException if the solver is file-backed or cannot make a guess
+    (e.g. some word is not in its dictionary, like Evaluate()).
+*/
+std::vector<short> EvaluateAll(WordleSolver &solver, const std::vector<std::string> &words);
+
+/*
+Overloaded version of EvaluateAll that looks up feedback in a FeedbackMatrix.
+
+Parameters:
+    solver: An in-memory WordleSolver with a deterministic ranker.
+    words: 5-letter words.
+    matrix: Precomputed feedback for the solver's dictionary (see Evaluate()).
+
+Returns:
+    Guess counts (as returned by Evaluate()) in the same order as words.
+*/
+std::vector<short> EvaluateAll(WordleSolver &solver, const std::vector<std::string> &words, const FeedbackMatrix &matrix);
+
 /*
 Computes various statistics on a WordleSolver's performance.
 
@@ -68,7 +141,12 @@ Builds and evaluates a collection of WordleSolvers on a list of words.
 
 For each dictionary filepath and ranking scheme, a WordleSolver is created and evaluated
 on a list of words using Evaluate(). Statistics from the evaluation are calculated using
-GetStatistics() and then are written to a TSV file.
+GetStatistics() and then are written to a TSV file. The solvers share an in-memory
+OpeningBook, so the first two guesses of a deterministic ranker are only ranked once,
+and a FingerprintCache of statistics (see WordleSolver::SetStatisticsCache) whose hit
+and miss counts are printed at the end.
+Solvers with a deterministic ranker are evaluated on all the words at once with
+EvaluateAll(), the others on one word at a time with Evaluate().
 
 Parameters:
     dictionary_fps: Container of dictionary filepaths. Will be cutoff in output file if
@@ -80,4 +158,126 @@ Parameters:
 */
 void GridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp);
 
+/*
+Overloaded version of GridEvaluate that can use a FeedbackMatrix for each dictionary.
+
+Parameters:
+    dictionary_fps: Container of dictionary filepaths. Will be cutoff in output file if
+    over 40 characters.
+    rankers: Container of ranking schemes specified via AbstractRanker pointers.
+    words_fp: Filepath of 5-letter words to evaluate solvers on. Assumed words in this 
+    filecan be stored in memory. If words_fp is at path.txt then the output will be
+    at path-output.txt. 
+    use_feedback_matrix: If true, the FeedbackMatrix of each dictionary is loaded from
+    (or built and saved to) FeedbackMatrix::GetDefaultFilePath and used by the solvers
+    and by Evaluate. The output is the same either way.
+*/
+void GridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp, bool use_feedback_matrix);
+
+/*
+Overloaded version of GridEvaluate that controls how many threads are used.
+
+With more than one thread, each (dictionary, ranker) pair is spread over a
+work-stealing ThreadPool. If the ranker is deterministic, the words are split
+into groups by the feedback they give the first guess and each group is one
+task (so the games in a group keep sharing guesses, see EvaluateAll, and a
+pair can use every thread), otherwise the tasks are chunks of words. Every worker evaluates
+with its own AbstractRanker::Clone of the ranker, so the passed rankers are never
+used concurrently (or at all). The output file and console output are the same
+as with one thread (same rows in the same order).
+
+Parameters:
+    dictionary_fps: Container of dictionary filepaths. Will be cutoff in output file if
+    over 40 characters.
+    rankers: Container of ranking schemes specified via AbstractRanker pointers.
+    words_fp: Filepath of 5-letter words to evaluate solvers on. Assumed words in this 
+    filecan be stored in memory. If words_fp is at path.txt then the output will be
+    at path-output.txt. 
+    use_feedback_matrix: See GridEvaluate(...,bool).
+    num_threads: 1 evaluates serially on the calling thread with the passed rankers,
+    0 uses one thread per hardware thread. The other overloads use 0.
+*/
+void GridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp, bool use_feedback_matrix, size_t num_threads);
+
+/*
+Compares serial and parallel GridEvaluate.
+
+Runs GridEvaluate with 1 thread and then with one thread per hardware thread and
+prints both run times, the speedup, and whether the two output files are identical.
+
+Parameters:
+    dictionary_fps: See GridEvaluate.
+    rankers: See GridEvaluate.
+    words_fp: See GridEvaluate.
+*/
+void BenchmarkGridEvaluate(const std::vector<std::string> &dictionary_fps, const std::vector<AbstractRanker *> &rankers, const std::string &words_fp);
+
+/*
+Compares how long a solver takes per guess in and out of hard mode.
+
+Plays every word in a file with a solver in hard mode and then with one outside
+hard mode (see WordleSolver::SetHardMode) and prints for each the mean guess
+count and failures (as in GridEvaluate) and the mean and maximum time taken
+by the first guess and by the later guesses. The first guess is the same in
+both modes, the later guesses outside hard mode also rank the probe words.
+
+Parameters:
+    dictionary_fp: Dictionary filepath.
+    ranker: Ranking scheme.
+    words_fp: Filepath of 5-letter words to play (see GridEvaluate).
+*/
+void BenchmarkGuessLatency(const std::string &dictionary_fp, AbstractRanker *ranker, const std::string &words_fp);
+
+/*
+Compares evaluating a solver by playing every game with following its Strategy.
+
+Builds the Strategy of a hard mode solver, saves it to the dictionary's default
+strategy file (see Strategy::GetDefaultFilePath), and loads it again. Then every
+word in a file is evaluated with a StrategySolver following the loaded strategy
+and with a WordleSolver. Prints the time each step took, the strategy size, the
+mean guess count and failures of each, and whether the guess counts match.
+
+Parameters:
+    dictionary_fp: Dictionary filepath.
+    ranker: Deterministic ranking scheme.
+    words_fp: Filepath of 5-letter words to evaluate on (see GridEvaluate).
+*/
+void BenchmarkStrategy(const std::string &dictionary_fp, AbstractRanker *ranker, const std::string &words_fp);
+
+/*
+Compares two rankers that rank the same, e.g. a PipelineRanker and the chain of
+decorator rankers it is composed like.
+
+Both rankers are set up on every word of the dictionary, first as for the first
+guess and then with feedback that has found 3 letters (so stages that depend on
+progress are switched both ways), and rank every word of the dictionary a number
+of times with RankAll and with Rank. Prints the fastest time each takes and
+whether the ranks are the same. Then every word in a file is evaluated with a solver
+using each ranker, printing the time, mean guess count, and failures of each and
+whether the guess counts match.
+
+Parameters:
+    dictionary_fp: Dictionary filepath.
+    ranker1: Ranking scheme (e.g. the decorator chain).
+    ranker2: Ranking scheme expected to rank the same as ranker1.
+    words_fp: Filepath of 5-letter words to evaluate on (see GridEvaluate).
+*/
+void BenchmarkRankers(const std::string &dictionary_fp, AbstractRanker *ranker1, AbstractRanker *ranker2, const std::string &words_fp);
+
+/*
+Checks the FeedbackConstraint filtering kernels (scalar, SSE2, and AVX2)
+against each other and against GetFeedbackCode.
+
+Each word in a file is used as a guess, and for every distinct feedback it
+gets against the words in the file, the whole dictionary is filtered with each
+kernel supported by the CPU. Prints the total time each kernel takes and
+whether the words each kernel keeps are exactly the dictionary words that
+would have given that feedback.
+
+Parameters:
+    dictionary_fp: Dictionary filepath.
+    words_fp: Filepath of 5-letter words to use as guesses and solutions.
+*/
+void BenchmarkConstraintKernels(const std::string &dictionary_fp, const std::string &words_fp);
+
 #endif
\ No newline at end of file
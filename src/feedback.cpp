@@ -0,0 +1,74 @@
+// Implementation of feedback header
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "feedback.h"
+#include "dictionary.h"
+
+uint8_t EncodeFeedback(std::string_view feedback)
+{
+    // Horner's rule from the last position so position i gets weight 3^i
+    unsigned code{0};
+    for (auto i{WORD_LENGTH}; i > 0; i--)
+    {
+        code = 3 * code + ((feedback[i - 1] == 'g') ? 2 : (feedback[i - 1] == 'y'));
+    }
+    return static_cast<uint8_t>(code);
+}
+
+std::string DecodeFeedback(uint8_t code)
+{
+    std::string feedback(WORD_LENGTH, 'b');
+    for (auto i{0}; i < WORD_LENGTH; i++)
+    {
+        feedback[i] = "byg"[code % 3];
+        code /= 3;
+    }
+    return feedback;
+}
+
+uint8_t GetFeedbackCode(uint32_t guess_code, uint32_t word_code)
+{
+    // Weight of the base 3 digit of each position
+    static const uint8_t WEIGHTS[WORD_LENGTH]{1, 3, 9, 27, 81};
+
+    unsigned code{0};
+
+    // Bit i is set once word[i] has been accounted for by a green or yellow
+    unsigned used{0};
+
+    // Green pass, a letter in the right place uses up that letter of the word
+    for (auto i{0}; i < WORD_LENGTH; i++)
+    {
+        if (CodeLetter(guess_code, i) == CodeLetter(word_code, i))
+        {
+            code += 2 * WEIGHTS[i];
+            used |= 1u << i;
+        }
+    }
+
+    // Yellow pass, left to right each remaining guess letter uses up the first
+    // unused instance of it in the word. This ensures that if we duplicate a
+    // needed letter, it won't mark them both yellow. Example: guess "erect" for
+    // solution "runes" has feedback "yybbb".
+    for (auto i{0}; i < WORD_LENGTH; i++)
+    {
+        auto letter{CodeLetter(guess_code, i)};
+        if (letter == CodeLetter(word_code, i))
+        {
+            continue;
+        }
+
+        for (auto j{0}; j < WORD_LENGTH; j++)
+        {
+            if (((used >> j) & 1u) == 0 && CodeLetter(word_code, j) == letter)
+            {
+                code += WEIGHTS[i];
+                used |= 1u << j;
+                break;
+            }
+        }
+    }
+
+    return static_cast<uint8_t>(code);
+}
@@ -0,0 +1,63 @@
+/*
+Header for feedback codes.
+
+This file declares constants and functions for storing Wordle feedback
+compactly. Feedback on a 5 letter guess has 3^5 = 243 possible values
+so it fits in a single byte when written in base 3.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+// Number of distinct feedback codes (3^5)
+const unsigned short NUM_FEEDBACK_CODES{243};
+
+// Feedback code of "ggggg", i.e. the guess was the word
+const uint8_t ALL_GREEN_CODE{242};
+
+/*
+Converts feedback to a feedback code.
+
+Parameters:
+    feedback: Feedback in the form of 5 y's, g's, and b's.
+
+Returns:
+    The feedback as a base 3 number where the digit for position i has weight
+    3^i and is 0 for b, 1 for y, and 2 for g.
+*/
+uint8_t EncodeFeedback(std::string_view feedback);
+
+/*
+Converts a feedback code back to feedback.
+
+Parameters:
+    code: Feedback code as made by EncodeFeedback (0...242).
+
+Returns:
+    The feedback in the form of 5 y's, g's, and b's.
+*/
+std::string DecodeFeedback(uint8_t code);
+
+/*
+Derives the feedback code for a guess for a particular word.
+
+Does no heap allocation, this is the kernel behind GetFeedback in evaluation.h
+and FeedbackMatrix.
+
+Parameters:
+    guess_code: Packed guess (see EncodeWord in dictionary.h).
+    word_code: Packed word.
+
+Returns:
+    The feedback code (see EncodeFeedback).
+*/
+uint8_t GetFeedbackCode(uint32_t guess_code, uint32_t word_code);
+
+#endif
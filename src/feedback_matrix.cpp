@@ -0,0 +1,206 @@
+// Implementation of FeedbackMatrix
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "feedback_matrix.h"
+#include "feedback.h"
+#include "misc.h"
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <algorithm>
+
+// Header at the start of a matrix file, followed by the matrix in row-major order
+struct MatrixHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t num_words;
+    uint64_t dictionary_checksum;
+    uint64_t matrix_checksum;
+};
+
+// Identifies matrix files, version is increased if the layout changes
+static const char MATRIX_MAGIC[8]{'W', 'S', 'F', 'B', 'M', 'T', 'X', '\0'};
+static const uint32_t MATRIX_VERSION{2};
+
+class FeedbackMatrix::Private
+{
+public:
+    // Fills self.built with the matrix, rows are handed out to one thread per core
+    static void Build(FeedbackMatrix &self)
+    {
+        self.built.resize(self.num_words * self.num_words);
+        std::atomic<size_t> next_row{0};
+        auto worker{[&self, &next_row]()
+                    {
+                        auto word_codes{self.dictionary->GetCodes()};
+                        for (auto g{next_row++}; g < self.num_words; g = next_row++)
+                        {
+                            auto row{self.built.data() + g * self.num_words};
+                            for (size_t a{0}; a < self.num_words; a++)
+                            {
+                                row[a] = GetFeedbackCode(word_codes[g], word_codes[a]);
+                            }
+                        }
+                    }};
+
+        std::vector<std::thread> threads;
+        for (auto t{std::max(1u, std::thread::hardware_concurrency())}; t > 0; t--)
+        {
+            threads.emplace_back(worker);
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+        self.codes = self.built.data();
+    }
+
+    // Checksum of the n bytes of a matrix (FNV-1a over 8 bytes at a time, as
+    // byte at a time would take much longer than mapping the matrix)
+    static uint64_t Checksum(const uint8_t *codes, size_t n)
+    {
+        uint64_t checksum{14695981039346656037ull};
+        size_t i{0};
+        for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+        {
+            uint64_t block;
+            std::memcpy(&block, codes + i, sizeof(block));
+            checksum = (checksum ^ block) * 1099511628211ull;
+        }
+        for (; i < n; i++)
+        {
+            checksum = (checksum ^ codes[i]) * 1099511628211ull;
+        }
+        return checksum;
+    }
+
+    // Maps matrix_fp and points self.codes into it if it holds an intact matrix
+    // for self.dictionary, returns whether it did
+    static bool Load(FeedbackMatrix &self, const std::string &matrix_fp)
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(matrix_fp, error))
+        {
+            return false;
+        }
+
+        // A file that cannot be mapped is rebuilt like a stale one
+        std::unique_ptr<MappedFile> file;
+        try
+        {
+            file = std::make_unique<MappedFile>(matrix_fp);
+        }
+        catch (const WordleSolverException &)
+        {
+            return false;
+        }
+
+        MatrixHeader header;
+        if (file->Size() != sizeof(header) + self.num_words * self.num_words)
+        {
+            return false;
+        }
+
+        std::memcpy(&header, file->Data(), sizeof(header));
+        if (std::memcmp(header.magic, MATRIX_MAGIC, sizeof(MATRIX_MAGIC)) != 0 || header.version != MATRIX_VERSION ||
+            header.num_words != self.num_words || header.dictionary_checksum != self.dictionary->GetChecksum())
+        {
+            return false;
+        }
+
+        auto codes{reinterpret_cast<const uint8_t *>(file->Data() + sizeof(header))};
+        if (Checksum(codes, self.num_words * self.num_words) != header.matrix_checksum)
+        {
+            return false;
+        }
+
+        self.mapped = std::move(file);
+        self.codes = codes;
+        return true;
+    }
+
+    // Writes the matrix to matrix_fp, a temporary file is renamed into place so
+    // another process never maps a partially written matrix
+    static void Save(const FeedbackMatrix &self, const std::string &matrix_fp)
+    {
+        auto temp_fp{GetTempFilePath(matrix_fp)};
+        std::ofstream matrix_file(temp_fp, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!matrix_file.is_open())
+        {
+            throw WordleSolverException("Could not open " + temp_fp + " for writing");
+        }
+
+        MatrixHeader header{};
+        std::memcpy(header.magic, MATRIX_MAGIC, sizeof(MATRIX_MAGIC));
+        header.version = MATRIX_VERSION;
+        header.num_words = static_cast<uint32_t>(self.num_words);
+        header.dictionary_checksum = self.dictionary->GetChecksum();
+        header.matrix_checksum = Checksum(self.codes, self.num_words * self.num_words);
+        matrix_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        matrix_file.write(reinterpret_cast<const char *>(self.codes), self.num_words * self.num_words);
+        matrix_file.close();
+        if (!matrix_file)
+        {
+            std::error_code error;
+            std::filesystem::remove(temp_fp, error);
+            throw WordleSolverException("Could not write " + temp_fp);
+        }
+
+        ReplaceFile(temp_fp, matrix_fp);
+    }
+};
+
+FeedbackMatrix::FeedbackMatrix(std::shared_ptr<const Dictionary> d) : dictionary(d), num_words(d->Size()), codes(nullptr)
+{
+    Private::Build(*this);
+}
+
+FeedbackMatrix::FeedbackMatrix(std::shared_ptr<const Dictionary> d, const std::string &matrix_fp) : dictionary(d), num_words(d->Size()), codes(nullptr)
+{
+    if (!Private::Load(*this, matrix_fp))
+    {
+        Private::Build(*this);
+
+        // Saving only spares later runs from building the matrix, so the
+        // built matrix is used even if it cannot be saved
+        try
+        {
+            Private::Save(*this, matrix_fp);
+        }
+        catch (const WordleSolverException &)
+        {
+        }
+    }
+}
+
+const Dictionary &FeedbackMatrix::GetDictionary() const
+{
+    return *dictionary;
+}
+
+const uint8_t *FeedbackMatrix::Row(uint32_t guess_id) const
+{
+    return codes + static_cast<size_t>(guess_id) * num_words;
+}
+
+uint8_t FeedbackMatrix::Get(std::string_view guess, std::string_view answer) const
+{
+    uint32_t guess_id;
+    uint32_t answer_id;
+    if (dictionary->Find(guess, guess_id) && dictionary->Find(answer, answer_id))
+    {
+        return Get(guess_id, answer_id);
+    }
+    return GetFeedbackCode(EncodeWord(guess), EncodeWord(answer));
+}
+
+std::string FeedbackMatrix::GetDefaultFilePath(const std::string &dictionary_fp)
+{
+    std::filesystem::path matrix_path{dictionary_fp};
+    auto stem{matrix_path.stem().string()};
+    return matrix_path.replace_filename(stem + "-feedback.bin").string();
+}
@@ -0,0 +1,133 @@
+/*
+Header for FeedbackMatrix.
+
+This file declares the FeedbackMatrix class which stores the feedback for
+every (guess, answer) pair of words in a dictionary so it can be looked up
+instead of recomputed.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef FEEDBACK_MATRIX_H
+#define FEEDBACK_MATRIX_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "dictionary.h"
+#include "mapped_file.h"
+
+/*
+Matrix of feedback codes (see feedback.h) for a dictionary.
+
+Entry (g, a) is the feedback code for guessing the word with id g when the
+answer is the word with id a. For a dictionary of n words the matrix takes
+n^2 bytes (about 168 MB for the 12,971 words of dracos_github_words.txt), so
+it is built in parallel once, saved to a binary file, and memory-mapped on
+later runs. The file starts with a header recording the number of words,
+the dictionary checksum, and a checksum of the matrix so a file built for a
+different dictionary or corrupted since is never used.
+*/
+class FeedbackMatrix
+{
+public:
+    /*
+    Builds a FeedbackMatrix in memory.
+
+    Parameters:
+        d: Dictionary to build the matrix for.
+    */
+    FeedbackMatrix(std::shared_ptr<const Dictionary> d);
+
+    /*
+    Loads a FeedbackMatrix from a file, building and saving it if needed.
+
+    If matrix_fp holds a matrix for d whose checksum matches, it is
+    memory-mapped. Otherwise (the file does not exist, cannot be mapped, was
+    built for another dictionary, or is corrupted), the matrix is built and
+    written to matrix_fp. Writing is best effort: if matrix_fp cannot be
+    written, the built matrix is still used and the next run builds it again.
+
+    Parameters:
+        d: Dictionary to build the matrix for.
+        matrix_fp: Path to the binary matrix file.
+    */
+    FeedbackMatrix(std::shared_ptr<const Dictionary> d, const std::string &matrix_fp);
+
+    // Dictionary the matrix was built for.
+    const Dictionary &GetDictionary() const;
+
+    /*
+    Gets a feedback code by word ids.
+
+    Parameters:
+        guess_id: Id of the guess, not bounds checked.
+        answer_id: Id of the answer, not bounds checked.
+
+    Returns:
+        The feedback code.
+    */
+    uint8_t Get(uint32_t guess_id, uint32_t answer_id) const
+    {
+        return codes[static_cast<size_t>(guess_id) * num_words + answer_id];
+    }
+
+    /*
+    Gets the feedback codes of a guess against every answer.
+
+    Parameters:
+        guess_id: Id of the guess, not bounds checked.
+
+    Returns:
+        Pointer to GetDictionary().Size() codes indexed by answer id.
+    */
+    const uint8_t *Row(uint32_t guess_id) const;
+
+    /*
+    Gets a feedback code by words.
+
+    Parameters:
+        guess: A 5 letter word.
+        answer: A 5 letter word.
+
+    Returns:
+        The feedback code. It is looked up if both words are in the dictionary
+        and computed otherwise.
+    */
+    uint8_t Get(std::string_view guess, std::string_view answer) const;
+
+    /*
+    Gets the default path of the matrix file for a dictionary.
+
+    Parameters:
+        dictionary_fp: Path to a dictionary file.
+
+    Returns:
+        Path with the extension replaced, e.g. "a.txt" -> "a-feedback.bin".
+    */
+    static std::string GetDefaultFilePath(const std::string &dictionary_fp);
+
+private:
+    // Dictionary the matrix was built for
+    std::shared_ptr<const Dictionary> dictionary;
+
+    // Number of words in dictionary (rows and columns)
+    size_t num_words;
+
+    // Matrix in row-major order, points into built or mapped
+    const uint8_t *codes;
+
+    // Holds the matrix when it was built by this object
+    std::vector<uint8_t> built;
+
+    // Holds the matrix when it was loaded from a file
+    std::unique_ptr<MappedFile> mapped;
+
+    // Inner class that holds private helper functions
+    class Private;
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*
+Header for FingerprintCache.
+
+This file declares the FingerprintCache class template which keeps values
+computed for sets of eligible words (identified by their fingerprint, see
+EligibleWords::GetFingerprint) so they can be reused when another game or
+solver reaches the same words.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef FINGERPRINT_CACHE_H
+#define FINGERPRINT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include "misc.h"
+
+/*
+Scrambles a 64-bit value (the splitmix64 finalizer).
+
+Fingerprints are built by combining the scrambled values of their parts, so
+fingerprints of similar sets (e.g. that differ by one word) are unrelated.
+
+Parameters:
+    value: Value to scramble.
+
+Returns:
+    The scrambled value.
+*/
+inline uint64_t MixFingerprint(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
+/*
+Bounded cache of values by fingerprint that evicts the least recently used.
+
+Values are stored as shared pointers to const so a value found by one thread
+can be read while it is evicted or replaced by another. Every Find counts as
+a hit or a miss. A cache can be shared by solvers on different threads.
+
+A fingerprint is 64 bits, so two different keys are assumed to never have the
+same fingerprint.
+
+Implementation in header because it is a template, see CountsToRanks in misc.h.
+
+Template:
+    Value: Type of the cached values.
+*/
+template <typename Value>
+class FingerprintCache
+{
+public:
+    /*
+    Creates an empty cache.
+
+    Parameters:
+        capacity: Most values kept at once.
+
+    Throws:
+        WordleSolverException if capacity is 0.
+    */
+    FingerprintCache(size_t capacity) : capacity(capacity), hits(0), misses(0)
+    {
+        if (capacity == 0)
+        {
+            throw WordleSolverException("A fingerprint cache must be able to hold at least 1 value");
+        }
+    }
+
+    /*
+    Finds a value, making it the most recently used.
+
+    Parameters:
+        fingerprint: Fingerprint of the value's key.
+
+    Returns:
+        The value, nullptr if it is not cached.
+    */
+    std::shared_ptr<const Value> Find(uint64_t fingerprint)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto itr{index.find(fingerprint)};
+        if (itr == index.end())
+        {
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        entries.splice(entries.begin(), entries, itr->second);
+        return itr->second->second;
+    }
+
+    /*
+    Adds (or replaces) a value as the most recently used, evicting the least
+    recently used value if the cache is full.
+
+    Parameters:
+        fingerprint: Fingerprint of the value's key.
+        value: Value to cache.
+    */
+    void Insert(uint64_t fingerprint, std::shared_ptr<const Value> value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto itr{index.find(fingerprint)};
+        if (itr != index.end())
+        {
+            itr->second->second = std::move(value);
+            entries.splice(entries.begin(), entries, itr->second);
+            return;
+        }
+
+        if (entries.size() == capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(fingerprint, std::move(value));
+        index[fingerprint] = entries.begin();
+    }
+
+    // Number of calls to Find that found a value.
+    size_t GetHits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hits;
+    }
+
+    // Number of calls to Find that did not find a value.
+    size_t GetMisses() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return misses;
+    }
+
+    // Number of values in the cache.
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    // Most values kept at once.
+    size_t GetCapacity() const
+    {
+        return capacity;
+    }
+
+private:
+    // Guards everything below
+    mutable std::mutex mutex;
+
+    // Most values kept at once
+    size_t capacity;
+
+    // Values with their fingerprints, most recently used first
+    std::list<std::pair<uint64_t, std::shared_ptr<const Value>>> entries;
+
+    // Where each fingerprint's value is in entries
+    std::unordered_map<uint64_t, typename std::list<std::pair<uint64_t, std::shared_ptr<const Value>>>::iterator> index;
+
+    // Counts of Find calls that found and did not find a value
+    size_t hits;
+    size_t misses;
+};
+
+#endif
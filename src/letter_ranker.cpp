@@ -3,63 +3,51 @@
 // Date: Summer 2022
 
 #include "letter_ranker.h"
-#include <fstream>
 #include "misc.h"
 #include <vector>
 #include <algorithm>
 #include <limits>
-#include <unordered_set>
 #include <stdint.h>
 
 LetterRanker::LetterRanker() : AbstractRanker("LetterRanker()") {}
 
 LetterRanker::LetterRanker(std::string_view name) : AbstractRanker(name) {}
 
-void LetterRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void LetterRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
-    std::ifstream eligible_file(eligible_fp, std::ios_base::in);
-    if (!eligible_file.is_open())
+    // Letter counts are computed once per set of eligible words and shared
+    word_counts = eligible.GetStatistics().GetLetterCounts();
+    CountsToRanks(word_counts, ranking, letters);
+}
+
+int LetterRanker::Rank(std::string_view word) const
+{
+    // Sums rank of letters in word
+    int rank{0};
+    for (auto c : word)
     {
-        throw WordleSolverException("Could not open " + eligible_fp + " for reading");
+        rank += ranking[c - 'a'];
     }
+    return rank;
+}
 
-    // Stores the current word read from file
-    std::string word;
-
-    // Stores the unique characters in word
-    std::unordered_set<char> unique_chars;
-
-    // Read over each letter in each eligible word and increase its count after resetting counts.
-    word_counts.clear();
-    while (eligible_file.good())
+void LetterRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    // Sums rank of the packed letters of each word
+    for (size_t i{0}; i < words.size(); i++)
     {
-        std::getline(eligible_file, word);
-        for (auto c : word)
+        int rank{0};
+        for (unsigned short j{0}; j < WORD_LENGTH; j++)
         {
-            if (unique_chars.find(c) == unique_chars.end())
-            {
-                word_counts[c]++;
-                unique_chars.insert(c);
-            }
+            rank += ranking[CodeLetter(words[i].code, j)];
         }
-
-        // Clear unique characters for next word
-        unique_chars.clear();
+        ranks[i] = rank;
     }
-    eligible_file.close();
-
-    CountsToRanks(word_counts, ranking, letters);
 }
 
-int LetterRanker::Rank(std::string_view word) const
+std::unique_ptr<AbstractRanker> LetterRanker::Clone() const
 {
-    // Sums rank of letters in word using map
-    int rank{0};
-    for (const auto &c : word)
-    {
-        rank += ranking.find(c)->second;
-    }
-    return rank;
+    return std::make_unique<LetterRanker>(*this);
 }
 
 std::string LetterRanker::GetDebugInfo() const
@@ -69,17 +57,44 @@ std::string LetterRanker::GetDebugInfo() const
     debug_info.reserve(letters.size() * 10);
     for (auto l : letters)
     {
-        debug_info += l;
+        debug_info += static_cast<char>('a' + l);
         debug_info += ": ";
-        debug_info += std::to_string(ranking.find(l)->second);
+        debug_info += std::to_string(ranking[l]);
         debug_info += " ";
-        debug_info += std::to_string(word_counts.find(l)->second);
+        debug_info += std::to_string(word_counts[l]);
         debug_info += "\n";
     }
 
     return debug_info;
 }
 
+class SubstringRanker::Private
+{
+public:
+    // Code of the n letter substring of word starting at i (see SubstringCode)
+    static uint32_t SubstringCode(std::string_view word, size_t i, unsigned short n)
+    {
+        uint32_t code{0};
+        for (auto j{i}; j < i + n; j++)
+        {
+            code = code * NUM_LETTERS + (word[j] - 'a');
+        }
+        return code;
+    }
+
+    // Letters of the n letter substring with a given code
+    static std::string SubstringLetters(uint32_t code, unsigned short n)
+    {
+        std::string letters(n, 'a');
+        for (auto j{n}; j > 0; j--)
+        {
+            letters[j - 1] = static_cast<char>('a' + code % NUM_LETTERS);
+            code /= NUM_LETTERS;
+        }
+        return letters;
+    }
+};
+
 SubstringRanker::SubstringRanker(unsigned short n) : SubstringRanker("SubstringRanker(" + std::to_string(n) + ")", n) {}
 
 SubstringRanker::SubstringRanker(std::string_view name, unsigned short n) : AbstractRanker(name)
@@ -91,73 +106,136 @@ SubstringRanker::SubstringRanker(std::string_view name, unsigned short n) : Abst
     substring_len = n;
 }
 
-void SubstringRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+SubstringRanker::SubstringRanker(const SubstringRanker &other) : AbstractRanker(other), substring_len{other.substring_len}
 {
-    std::ifstream eligible_file(eligible_fp, std::ios_base::in);
-    if (!eligible_file.is_open())
+    // Rankers are usually cloned before their first SetUp, so there is
+    // typically nothing to copy and the copy allocates its tables in SetUp
+    if (other.tables != nullptr)
     {
-        throw WordleSolverException("Could not open " + eligible_fp + " for reading");
+        tables = std::make_unique<Tables>(*other.tables);
     }
+}
 
-    // Stores the current word read from file
-    std::string word;
-
-    // Stores the unique n letter substrings in word
-    std::unordered_set<std::string> unique_substrs;
-
-    // Used to prevent size_t(0) bug
-    auto itr_offset{substring_len-1};
-
-    // Read over each substring in each eligible word and increase its count after resetting word_counts.
-    word_counts.clear();
-    while (eligible_file.good())
+void SubstringRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
+{
+    if (tables == nullptr)
     {
-        std::getline(eligible_file, word);
-        // For n=2, goes 1,2,...4
-        for (auto i{itr_offset}; i < word.size(); i++)
+        // One entry per possible substring (26^n, at most 456976 for n = 4)
+        size_t num_codes{1};
+        for (auto i{0}; i < substring_len; i++)
         {
-            // Substr is 1-1=0 to 1 inclusive for n=2
-            auto substr{word.substr(i - itr_offset, substring_len)};
-            if (unique_substrs.find(substr) == unique_substrs.end())
-            {
-                word_counts[substr]++;
-                unique_substrs.insert(substr);
-            }
+            num_codes *= NUM_LETTERS;
         }
+        tables = std::make_unique<Tables>();
+        tables->word_counts.assign(num_codes, 0);
+        tables->ranking.assign(num_codes, 0);
+    }
+    else
+    {
+        // Reset only the counts set by the previous SetUp
+        for (auto code : tables->substrings)
+        {
+            tables->word_counts[code] = 0;
+            tables->ranking[code] = 0;
+        }
+        tables->substrings.clear();
+    }
+    auto &word_counts{tables->word_counts};
+    auto &substrings{tables->substrings};
 
-        // Clear unique substrings for next word
-        unique_substrs.clear();
+    // 2 and 3 letter substrings are counted once per set of eligible words and shared
+    if (substring_len <= EligibleStatistics::MAX_SUBSTRING_LEN)
+    {
+        const auto &statistics{eligible.GetStatistics()};
+        const auto &counts{statistics.GetSubstringCounts(substring_len)};
+        substrings = statistics.GetSubstrings(substring_len);
+        for (auto code : substrings)
+        {
+            word_counts[code] = counts[code];
+        }
+        CountsToRanks(word_counts, tables->ranking, substrings);
+        return;
     }
-    eligible_file.close();
 
-    CountsToRanks(word_counts, ranking, substrings);
+    // Read over each substring in each eligible word and increase its count,
+    // counting each substring once per word (a word has at most 4)
+    auto num_substrs{WORD_LENGTH - (substring_len - 1)};
+    eligible.ForEach([this, &num_substrs, &word_counts, &substrings](std::string_view word)
+                     {
+        uint32_t word_substrs[WORD_LENGTH];
+        for (auto i{0}; i < num_substrs; i++)
+        {
+            auto code{Private::SubstringCode(word, i, substring_len)};
+            word_substrs[i] = code;
+            if (std::find(word_substrs, word_substrs + i, code) != word_substrs + i)
+            {
+                continue;
+            }
+            if (word_counts[code]++ == 0)
+            {
+                substrings.push_back(code);
+            }
+        } });
+
+    CountsToRanks(word_counts, tables->ranking, substrings);
 }
 
 int SubstringRanker::Rank(std::string_view word) const
 {
-    // Sums rank of substrings in word using map
+    // Sums rank of substrings in word (0 before the first SetUp)
     int rank{0};
-    for (auto i{0}; i < word.size() - (substring_len - 1); i++)
+    if (tables == nullptr)
+    {
+        return rank;
+    }
+    for (size_t i{0}; i < word.size() - (substring_len - 1); i++)
     {
-        // Can't seem to find with string_views (https://stackoverflow.com/a/53530846)
-        // Should find optimization for this - may need to change ranker ADT
-        rank += ranking.find(std::string(word.substr(i, substring_len)))->second;
+        rank += tables->ranking[Private::SubstringCode(word, i, substring_len)];
     }
     return rank;
 }
 
+void SubstringRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    // Sums rank of the substrings of each packed word (0 before the first SetUp)
+    if (tables == nullptr)
+    {
+        std::fill(ranks.begin(), ranks.begin() + words.size(), 0);
+        return;
+    }
+    const auto &ranking{tables->ranking};
+    for (size_t i{0}; i < words.size(); i++)
+    {
+        int rank{0};
+        for (unsigned short j{0}; j < WORD_LENGTH - (substring_len - 1); j++)
+        {
+            rank += ranking[SubstringCode(words[i].code, j, substring_len)];
+        }
+        ranks[i] = rank;
+    }
+}
+
+std::unique_ptr<AbstractRanker> SubstringRanker::Clone() const
+{
+    return std::make_unique<SubstringRanker>(*this);
+}
+
 std::string SubstringRanker::GetDebugInfo() const
 {
     // https://stackoverflow.com/questions/18892281/most-optimized-way-of-concatenation-in-strings
     std::string debug_info;
-    debug_info.reserve(substrings.size() * 10);
-    for (const auto &s : substrings)
+    if (tables == nullptr)
+    {
+        return debug_info;
+    }
+    debug_info.reserve(tables->substrings.size() * 10);
+    for (auto s : tables->substrings)
     {
-        debug_info += s;
+        debug_info += Private::SubstringLetters(s, substring_len);
         debug_info += ": ";
-        debug_info += std::to_string(ranking.find(s)->second);
+        debug_info += std::to_string(tables->ranking[s]);
         debug_info += " ";
-        debug_info += std::to_string(word_counts.find(s)->second);
+        debug_info += std::to_string(tables->word_counts[s]);
         debug_info += "\n";
     }
 
@@ -11,8 +11,9 @@ Date: Summer 2022
 #define LETTER_RANKER_H
 
 #include "ranker.h"
-#include <unordered_map>
 #include <vector>
+#include <array>
+#include <cstdint>
 
 /*
 This class defines a ranking scheme based on letter frequency.
@@ -44,12 +45,12 @@ public:
     words (not in the original dictionary).
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes the rank of a word as the sum of its letter ranks.
@@ -64,6 +65,12 @@ public:
     */
     int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    std::unique_ptr<AbstractRanker> Clone() const override;
+
     /*
     Gets a string with letters ranking and count information.
 
@@ -76,35 +83,34 @@ public:
 
 private:
     /*
-    Stores the frequencies of each letter that appears in the eligible words.
-    If we have words "abbbb" and "aabbb" then word_counts['a'] = 2 (not 3).
+    Stores the frequencies of each letter (as 0-25) in the eligible words.
+    If we have words "abbbb" and "aabbb" then word_counts[0] = 2 (not 3).
     That is, it functions akin to performing a grep + wc on the words file.
-    Assuming only letters a-z, this could be replaced by a length 26 int
-    array. This is updated by SetUp which, as described in WordleSolver,
-    is called before each guess is made so that the ranking map can be
+    This is updated by SetUp which, as described in WordleSolver,
+    is called before each guess is made so that the ranking can be
     updated. Note, the letters that were most frequent in the overall
     dictionary may not the best most frequent after the dictionary has
     been reduced via various rounds of feedback.
     */
-    std::unordered_map<char, size_t> word_counts;
+    std::array<size_t, NUM_LETTERS> word_counts;
 
     /*
-    Stores the rank (1,2,...) of each letter that appears in the eligible words.
-    Assuming only letters a-z, this could be replaced by a length 26
-    int array. This is updated by SetUp which, as described in WordleSolver,
-    is called before each guess is made so that ranking can be adjusted
-    for the eligible words. Note, the letters that were most frequent
-    in the overall dictionary may not the best most frequent after the
-    dictionary has been reduced via various rounds of feedback.
+    Stores the rank (1,2,...) of each letter (as 0-25) that appears in the
+    eligible words (0 for letters that do not appear). This is updated by
+    SetUp which, as described in WordleSolver, is called before each guess
+    is made so that ranking can be adjusted for the eligible words. Note,
+    the letters that were most frequent in the overall dictionary may not
+    the best most frequent after the dictionary has been reduced via various
+    rounds of feedback. As an array of 26 ints it fits in two cache lines.
     */
-    std::unordered_map<char, int> ranking;
+    std::array<int, NUM_LETTERS> ranking;
 
     /*
-    Stores the keys of ranking and counts, that is the letters in the eligible
-    words file, sorted by their rank. That is, letters[0] is the letter that
-    occurs most frequently in the eligible words file.
+    Stores the letters (as 0-25) in the eligible words sorted by their rank.
+    That is, letters[0] is the letter that occurs most frequently in the
+    eligible words file.
     */
-    std::vector<char> letters;
+    std::vector<unsigned short> letters;
 };
 
 /*
@@ -135,6 +141,14 @@ public:
     */
     SubstringRanker(std::string_view name, unsigned short n);
 
+    /*
+    Constructs a copy of a SubstringRanker with its own tables.
+
+    Parameters:
+        other: SubstringRanker to copy
+    */
+    SubstringRanker(const SubstringRanker &other);
+
     /*
     Sets up a SubstringRanker to rank based on the currently eligible words.
 
@@ -142,12 +156,12 @@ public:
     in the eligible words (not in the original dictionary).
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes the rank of a word as the sum of its n letter substring ranks.
@@ -162,6 +176,12 @@ public:
     */
     int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    std::unique_ptr<AbstractRanker> Clone() const override;
+
     /*
     Gets a string with substrings ranking and count information.
 
@@ -174,35 +194,56 @@ public:
 
 private:
     /*
-    Stores the frequencies of each n letter substring that appears in
-    the eligible words. If we have words "abbbb" and "aabbb" and n = 2 then
-    word_counts['bb'] = 2 (not 5). That is, it functions akin to performing
-    a grep + wc on the words file. This is updated by SetUp which, as
-    described in WordleSolver, is called before each guess is made
-    so that the ranking map can be updated. Note, the n letter substrings
-    that were most frequent in the overall dictionary may not the best
-    most frequent after the dictionary has been reduced via various rounds
-    of feedback.
-    */
-    std::unordered_map<std::string, size_t> word_counts;
-
-    /*
-    Stores the rank (1,2,...) of each two letter substring that appears
-    in the eligible words. This is updated by SetUp which, as described
-    in WordleSolver, is called before each guess is made so that ranking
-    can be adjusted for the eligible words.
-    Note, the n letter substrings that were most frequent in the
-    overall dictionary may not the best most frequent after the
-    dictionary has been reduced via various rounds of feedback.
-    */
-    std::unordered_map<std::string, int> ranking;
-
-    /*
-    Stores the keys of ranking and counts, that is the n letter substrings
-    in the eligible words file, sorted by their rank. That is, substrings[0]
-    is the substring that occurs most frequently in the eligible words file.
-    */
-    std::vector<std::string> substrings;
+    Inner class that holds private helper functions of SubstringRanker. See
+    https://stackoverflow.com/a/28734794.
+    */
+    class Private;
+
+    // Tables computed by SetUp for the eligible words
+    struct Tables
+    {
+        /*
+        Stores the frequencies of each n letter substring that appears in
+        the eligible words, indexed by the substring's code (its letters as a
+        base 26 number, see Private::SubstringCode). If we have words "abbbb"
+        and "aabbb" and n = 2 then the count of "bb" is 2 (not 5). That is, it
+        functions akin to performing a grep + wc on the words file. This is
+        updated by SetUp which, as described in WordleSolver, is called before
+        each guess is made so that the ranking can be updated. Note, the n
+        letter substrings that were most frequent in the overall dictionary
+        may not the best most frequent after the dictionary has been reduced
+        via various rounds of feedback. Has 26^n entries, only the entries of
+        substrings are non-zero.
+        */
+        std::vector<uint32_t> word_counts;
+
+        /*
+        Stores the rank (1,2,...) of each n letter substring that appears
+        in the eligible words, indexed like word_counts. This is updated by
+        SetUp which, as described in WordleSolver, is called before each guess
+        is made so that ranking can be adjusted for the eligible words.
+        Note, the n letter substrings that were most frequent in the
+        overall dictionary may not the best most frequent after the
+        dictionary has been reduced via various rounds of feedback.
+        */
+        std::vector<int> ranking;
+
+        /*
+        Stores the codes of the n letter substrings in the eligible words file,
+        sorted by their rank. That is, substrings[0] is the substring that
+        occurs most frequently in the eligible words file. SetUp only has to
+        reset these entries of word_counts.
+        */
+        std::vector<uint32_t> substrings;
+    };
+
+    /*
+    The tables (nullptr before the first SetUp). For n = 4 they take a few
+    MB, so they are allocated by the first SetUp and reused by later ones.
+    A copy of a ranker that has not been set up allocates its own tables in
+    its first SetUp.
+    */
+    std::unique_ptr<Tables> tables;
 
     // Stores n
     unsigned short substring_len;
@@ -15,10 +15,19 @@
 #include "vowel_ranker.h"
 #include <cstring>
 #include "combined_ranker.h"
+#include "entropy_ranker.h"
+#include "partition_ranker.h"
+#include "ranker_pipeline.h"
 
 /*
 Main function - by default uses RunUserMode, can alternatively make
-use of evaluation header.
+use of evaluation header (-e runs GridEvaluate, -b compares serial and
+parallel GridEvaluate, -l compares guess latency in and out of hard mode,
+-s compares following a precomputed Strategy with playing every game, -p compares
+the decorator chain used in user mode with the equivalent Pipeline, -k checks
+the SIMD and scalar FeedbackConstraint kernels against each other). -c compiles
+the dictionaries (with popularity ranks) into binary files that are then loaded
+in place of the text files.
 */
 int main(int argc, char *argv[])
 {
@@ -31,7 +40,7 @@ int main(int argc, char *argv[])
     ProgressVowelRanker rl3(&rl2, 2);
     ProgressWordFrequencyRanker rl4(&rl3, freq_fp, 3);
 
-    if (argc == 2 && strcmp(argv[1], "-e") == 0)
+    if (argc == 2 && (strcmp(argv[1], "-e") == 0 || strcmp(argv[1], "-b") == 0))
     {
         RandomRanker r1(1);
         LetterRanker r2;
@@ -133,10 +142,52 @@ int main(int argc, char *argv[])
         ProgressDuplicateRanker r98(&r39, 100);
         ProgressDuplicateRanker r99(&r39, 100, 3);
         ProgressDuplicateRanker r100(&r39, 100, 4);
+        EntropyRanker r101;
+        MinimaxRanker r102;
+        ExpectedSizeRanker r103;
 
-        // &r1,&r2,&r3,&r4,&r5,&r6,&r7,&r8,&r9,&r10,&r11,&r12,&r13,&r14,&r15,&r16,&r17,&r18,&r19,&r20,&r21,&r22,&r23,&r24,&r25,&r26,&r27,&r28,&r29,&r30,&r31,&r32,&r33,&r34,&r35,&r36,&r37,&r38,&r39,&r40,&r41,&r42,&r43,&r44,&r45,&r46,&r47,&r48,&r49,&r50,&r51,&r52,&r53,&r54,&r55,&r56,&r57,&r58,&r59,&r60,&r61,&r62,&r63,&r64,&r65,&r66,&r67,&r68,&r69,&r70,&r71,&r72,&r73,&r74,&r75,&r76,&r77,&r78,&r79,&r80,&r81,&r82,&r83,&r84,&r85,&r86,&r87,&r88,&r89,&r90,&r91,&r92,&r93,&r94,&r95,&r96,&r97,&r98,&r99,&r100
+        // &r1,&r2,&r3,&r4,&r5,&r6,&r7,&r8,&r9,&r10,&r11,&r12,&r13,&r14,&r15,&r16,&r17,&r18,&r19,&r20,&r21,&r22,&r23,&r24,&r25,&r26,&r27,&r28,&r29,&r30,&r31,&r32,&r33,&r34,&r35,&r36,&r37,&r38,&r39,&r40,&r41,&r42,&r43,&r44,&r45,&r46,&r47,&r48,&r49,&r50,&r51,&r52,&r53,&r54,&r55,&r56,&r57,&r58,&r59,&r60,&r61,&r62,&r63,&r64,&r65,&r66,&r67,&r68,&r69,&r70,&r71,&r72,&r73,&r74,&r75,&r76,&r77,&r78,&r79,&r80,&r81,&r82,&r83,&r84,&r85,&r86,&r87,&r88,&r89,&r90,&r91,&r92,&r93,&r94,&r95,&r96,&r97,&r98,&r99,&r100,&r101,&r102,&r103
         std::vector<AbstractRanker *> rankers{&r3, &r4};
-        GridEvaluate(dictionary_fps, rankers, "data/medium_wordle_words_todate.txt");
+        if (strcmp(argv[1], "-b") == 0)
+        {
+            BenchmarkGridEvaluate(dictionary_fps, rankers, "data/medium_wordle_words_todate.txt");
+        }
+        else
+        {
+            GridEvaluate(dictionary_fps, rankers, "data/medium_wordle_words_todate.txt");
+        }
+    }
+    else if (argc == 2 && strcmp(argv[1], "-l") == 0)
+    {
+        // Probe words are only worth guessing with a ranker that measures how
+        // well they split the eligible words
+        auto dictionary{std::make_shared<const Dictionary>(dictionary_fps[0])};
+        auto matrix{std::make_shared<const FeedbackMatrix>(dictionary, FeedbackMatrix::GetDefaultFilePath(dictionary_fps[0]))};
+        EntropyRanker ranker(matrix, 0, true);
+        BenchmarkGuessLatency(dictionary_fps[0], &ranker, "data/medium_wordle_words_todate.txt");
+    }
+    else if (argc == 2 && strcmp(argv[1], "-s") == 0)
+    {
+        BenchmarkStrategy(dictionary_fps[0], &rl4, "data/medium_wordle_words_todate.txt");
+    }
+    else if (argc == 2 && strcmp(argv[1], "-p") == 0)
+    {
+        using ProductionPipeline = Pipeline<ProgressWordFrequencyStage<3>, ProgressVowelStage<2>, ProgressDuplicateStage<100, 4>, CombinedRanker>;
+        PipelineRanker<ProductionPipeline> rp(ProductionPipeline(ProgressWordFrequencyStage<3>(freq_fp), {}, {}, CombinedRanker()));
+        BenchmarkRankers(dictionary_fps[0], &rl4, &rp, "data/medium_wordle_words_todate.txt");
+    }
+    else if (argc == 2 && strcmp(argv[1], "-k") == 0)
+    {
+        BenchmarkConstraintKernels(dictionary_fps[0], "data/medium_wordle_words_todate.txt");
+    }
+    else if (argc == 2 && strcmp(argv[1], "-c") == 0)
+    {
+        for (const auto &dictionary_fp : dictionary_fps)
+        {
+            auto binary_fp{Dictionary::GetDefaultFilePath(dictionary_fp)};
+            Dictionary::Compile(dictionary_fp, binary_fp, freq_fp);
+            std::cout << "Compiled " << dictionary_fp << " to " << binary_fp << std::endl;
+        }
     }
     else if (argc == 2 && strcmp(argv[1], "-d") == 0)
     {
@@ -0,0 +1,79 @@
+// Implementation of MappedFile
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "mapped_file.h"
+#include "misc.h"
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &fp) : data(nullptr), size(0)
+{
+#ifdef _WIN32
+    std::ifstream file(fp, std::ios_base::in | std::ios_base::binary);
+    if (!file.is_open())
+    {
+        throw WordleSolverException("Could not open " + fp + " for reading");
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    size = buffer.size();
+    data = buffer.empty() ? nullptr : buffer.data();
+#else
+    auto fd{open(fp.c_str(), O_RDONLY)};
+    if (fd < 0)
+    {
+        throw WordleSolverException("Could not open " + fp + " for reading");
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+    {
+        close(fd);
+        throw WordleSolverException("Could not get size of " + fp);
+    }
+
+    // mmap cannot map 0 bytes, an empty file is left with data = nullptr
+    size = static_cast<size_t>(file_stat.st_size);
+    if (size > 0)
+    {
+        auto mapping{mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+        if (mapping == MAP_FAILED)
+        {
+            close(fd);
+            throw WordleSolverException("Could not map " + fp + " into memory");
+        }
+        data = static_cast<const char *>(mapping);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+    if (data != nullptr)
+    {
+        munmap(const_cast<char *>(data), size);
+    }
+#endif
+}
+
+const char *MappedFile::Data() const
+{
+    return data;
+}
+
+size_t MappedFile::Size() const
+{
+    return size;
+}
@@ -0,0 +1,62 @@
+/*
+Header for MappedFile.
+
+This file declares the MappedFile class which gives read-only access to the
+contents of a file without copying them into memory where possible.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+#include <vector>
+
+/*
+Read-only view of a file's contents.
+
+On POSIX systems the file is memory-mapped so pages are only loaded as they
+are read and are shared between processes mapping the same file. On other
+systems the file is read into a buffer. Either way, Data() stays valid for
+the lifetime of the object. Copying is disabled as the object owns the
+mapping.
+*/
+class MappedFile
+{
+public:
+    /*
+    Maps a file.
+
+    Parameters:
+        fp: Path to the file.
+
+    Throws:
+        WordleSolverException if the file cannot be opened or mapped.
+    */
+    MappedFile(const std::string &fp);
+
+    // Unmaps the file.
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Start of the file's contents (nullptr if the file is empty).
+    const char *Data() const;
+
+    // Size of the file in bytes.
+    size_t Size() const;
+
+private:
+    // Start and size of the contents
+    const char *data;
+    size_t size;
+
+    // Holds the contents when memory mapping is not available
+    std::vector<char> buffer;
+};
+
+#endif
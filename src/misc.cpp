@@ -3,6 +3,10 @@
 // Date: Summer 2022
 
 #include "misc.h"
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <sstream>
 
 std::string InsertFilePathSuffix(const std::string &fp, const std::string &suffix)
 {
@@ -10,6 +14,35 @@ std::string InsertFilePathSuffix(const std::string &fp, const std::string &suffi
     return fp.substr(0, idx) + suffix + fp.substr(idx);
 }
 
+std::string GetTempFilePath(const std::string &fp)
+{
+    // Random suffixes are shared by all threads, random_device also differs
+    // between processes so suffixes from separate processes do not collide
+    static std::mutex suffix_mutex;
+    static std::mt19937_64 suffix_engine{std::random_device{}()};
+
+    std::ostringstream temp_fp;
+    temp_fp << fp << '.' << std::hex;
+    {
+        std::lock_guard<std::mutex> lock(suffix_mutex);
+        temp_fp << suffix_engine();
+    }
+    temp_fp << ".tmp";
+    return temp_fp.str();
+}
+
+void ReplaceFile(const std::string &temp_fp, const std::string &fp)
+{
+    std::error_code error;
+    std::filesystem::rename(temp_fp, fp, error);
+    if (error)
+    {
+        auto reason{error.message()};
+        std::filesystem::remove(temp_fp, error);
+        throw WordleSolverException("Could not replace " + fp + " with " + temp_fp + ": " + reason);
+    }
+}
+
 WordleSolverException::WordleSolverException(std::string_view r) : reason(r) {}
 
 const char *WordleSolverException::what() const throw()
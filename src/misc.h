@@ -14,6 +14,9 @@ Date: Summer 2022
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 /*
 Function that inserts a suffix into a filepath infront of the extension.
@@ -32,6 +35,34 @@ Returns:
 */
 std::string InsertFilePathSuffix(const std::string &fp, const std::string &suffix);
 
+/*
+Gets a path to write a file at before it replaces another file (see ReplaceFile).
+
+Parameters:
+    fp: Path of the file to replace.
+
+Returns:
+    A path in the same directory as fp with a random suffix, so writers in
+    other threads or processes replacing the same file use other paths.
+    Example: "a.bin" -> "a.bin.3f9c2e1a7b.tmp"
+*/
+std::string GetTempFilePath(const std::string &fp);
+
+/*
+Replaces a file with a file written at a temporary path by renaming it, so
+another process reads either the old or the new file and never a partially
+written one.
+
+Parameters:
+    temp_fp: Path of the new file (see GetTempFilePath).
+    fp: Path of the file to replace.
+
+Throws:
+    WordleSolverException if temp_fp cannot be renamed to fp, in which case
+    temp_fp is removed.
+*/
+void ReplaceFile(const std::string &temp_fp, const std::string &fp);
+
 /*
 WordleSolver exception class.
 
@@ -120,4 +151,114 @@ void CountsToRanks(const std::unordered_map<KeyType, size_t> &counts, std::unord
     }
 }
 
+/*
+Ranks the elements of a small alphabet based on their counts.
+
+Version of CountsToRanks for when the elements are 0...N-1 (e.g. letters as
+0-25) so counts and ranks can be stored in arrays. The position of each
+element is found by comparing every pair of present elements and counting
+how many come before it. This takes O(N^2) comparisons, which for small N
+(e.g. 26 letters) is cheap and needs no hashing or allocation beyond keys.
+
+Template:
+    N: Number of elements in the alphabet
+
+Parameters:
+    counts: counts[k] is the count of element k (not modified). Elements with
+            count 0 are treated as absent.
+    ranks: Will hold the rank of each element with a non-zero count as 1,2, and
+           so on (0 for absent elements). Rank 1 element had the highest count.
+           Elements with the same count have the same rank.
+    keys: Will hold the elements with a non-zero count in order of increasing
+          rank. Elements with the same rank are in increasing order.
+*/
+template <size_t N>
+void CountsToRanks(const std::array<size_t, N> &counts, std::array<int, N> &ranks, std::vector<unsigned short> &keys)
+{
+    ranks.fill(0);
+
+    // position[k] counts the present elements ordered before k
+    std::array<unsigned short, N> position{};
+    unsigned short num_present{0};
+    for (size_t k1{0}; k1 < N; k1++)
+    {
+        if (counts[k1] == 0)
+        {
+            continue;
+        }
+        num_present++;
+        for (size_t k2{k1 + 1}; k2 < N; k2++)
+        {
+            if (counts[k2] == 0)
+            {
+                continue;
+            }
+            // Higher count comes first, ties go to the smaller element (k1)
+            if (counts[k2] > counts[k1])
+            {
+                position[k1]++;
+            }
+            else
+            {
+                position[k2]++;
+            }
+        }
+    }
+
+    keys.resize(num_present);
+    for (size_t k{0}; k < N; k++)
+    {
+        if (counts[k] != 0)
+        {
+            keys[position[k]] = static_cast<unsigned short>(k);
+        }
+    }
+
+    int curr_rank{0};
+    size_t curr_score{0};
+    for (auto k : keys)
+    {
+        if (curr_rank == 0 || counts[k] < curr_score)
+        {
+            curr_rank++;
+            curr_score = counts[k];
+        }
+        ranks[k] = curr_rank;
+    }
+}
+
+/*
+Ranks the elements of a large alphabet based on their counts.
+
+Version of CountsToRanks for when the elements are 0...N-1 but N is too large
+to go over every element (e.g. substrings as base 26 numbers). Only the
+elements listed in keys are ranked.
+
+Parameters:
+    counts: counts[k] is the count of element k (not modified).
+    ranks: ranks[k] will hold the rank of each element k in keys as 1,2, and so
+           on (other entries are not modified). Rank 1 element had the highest
+           count. Elements with the same count have the same rank.
+    keys: On input, the distinct elements to rank (in any order). Will hold them
+          in order of increasing rank. Elements with the same rank are in
+          increasing order.
+*/
+inline void CountsToRanks(const std::vector<uint32_t> &counts, std::vector<int> &ranks, std::vector<uint32_t> &keys)
+{
+    std::sort(keys.begin(), keys.end(), [&counts](uint32_t key1, uint32_t key2)
+              { return counts[key1] > counts[key2] || (counts[key1] == counts[key2] && key1 < key2); });
+
+    int curr_rank{0};
+    uint32_t curr_score{0};
+    for (auto k : keys)
+    {
+        if (curr_rank == 0 || counts[k] < curr_score)
+        {
+            curr_rank++;
+            curr_score = counts[k];
+        }
+        ranks[k] = curr_rank;
+    }
+}
+
 #endif
\ No newline at end of file
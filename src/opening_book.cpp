@@ -0,0 +1,186 @@
+// Implementation of OpeningBook
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "opening_book.h"
+#include "misc.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+class OpeningBook::Private
+{
+public:
+    // Separates the fields of a line of the book file and the second guesses
+    static const char FIELD_SEPARATOR{'\t'};
+    static const char GUESS_SEPARATOR{','};
+
+    // Number of fields in a line: checksum, size, hard mode, ranker data
+    // checksum, ranker name, first guess, and second guesses
+    static const size_t NUM_FIELDS{7};
+
+    // Number of fields in a line of books written before the ranker data
+    // checksum was part of the key
+    static const size_t NUM_FIELDS_WITHOUT_DATA_CHECKSUM{6};
+
+    // Stands in for a missing second guess in the book file
+    static constexpr std::string_view NO_GUESS{"-"};
+
+    // Builds the key of an opening, which is also how it starts in the book file
+    static std::string Key(const Dictionary &d, const AbstractRanker &r, bool hard_mode)
+    {
+        std::ostringstream key;
+        key << std::hex << d.GetChecksum() << std::dec << FIELD_SEPARATOR << d.Size() << FIELD_SEPARATOR << hard_mode << FIELD_SEPARATOR
+            << std::hex << r.GetDataChecksum() << std::dec << FIELD_SEPARATOR << r.GetName();
+        return key.str();
+    }
+
+    // Splits s on separator
+    static std::vector<std::string> Split(const std::string &s, char separator)
+    {
+        std::vector<std::string> parts;
+        std::istringstream iss(s);
+        std::string part;
+        while (std::getline(iss, part, separator))
+        {
+            parts.push_back(part);
+        }
+        return parts;
+    }
+
+    // Reads the openings in the book file (if there is one)
+    static void Load(OpeningBook &self)
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(self.book_fp, error))
+        {
+            return;
+        }
+
+        std::ifstream book_file(self.book_fp, std::ios_base::in);
+        if (!book_file.is_open())
+        {
+            throw WordleSolverException("Could not open " + self.book_fp + " for reading");
+        }
+
+        std::string line;
+        while (std::getline(book_file, line))
+        {
+            auto fields{Split(line, FIELD_SEPARATOR)};
+
+            // Openings from before the data checksum cannot be told apart from
+            // stale ones, so they are dropped (and ranked again when needed)
+            if (fields.size() == NUM_FIELDS_WITHOUT_DATA_CHECKSUM)
+            {
+                continue;
+            }
+
+            auto seconds{fields.size() == NUM_FIELDS ? Split(fields.back(), GUESS_SEPARATOR) : std::vector<std::string>{}};
+            if (seconds.size() != NUM_FEEDBACK_CODES)
+            {
+                throw WordleSolverException("Invalid opening in " + self.book_fp + ": " + line);
+            }
+
+            Opening opening;
+            opening.first = fields[NUM_FIELDS - 2];
+            for (size_t c{0}; c < NUM_FEEDBACK_CODES; c++)
+            {
+                opening.second[c] = (seconds[c] == NO_GUESS) ? "" : seconds[c];
+            }
+
+            // The key is the line up to the first guess
+            auto key_end{line.size() - fields[NUM_FIELDS - 2].size() - fields.back().size() - 2};
+            self.openings[line.substr(0, key_end)] = opening;
+        }
+    }
+
+    // Writes every opening to the book file, a temporary file is renamed into
+    // place so another process never reads a partially written book
+    static void Save(const OpeningBook &self)
+    {
+        auto temp_fp{GetTempFilePath(self.book_fp)};
+        std::ofstream book_file(temp_fp, std::ios_base::out | std::ios_base::trunc);
+        if (!book_file.is_open())
+        {
+            throw WordleSolverException("Could not open " + temp_fp + " for writing");
+        }
+
+        for (const auto &[key, opening] : self.openings)
+        {
+            book_file << key << FIELD_SEPARATOR << opening.first << FIELD_SEPARATOR;
+            for (size_t c{0}; c < NUM_FEEDBACK_CODES; c++)
+            {
+                if (c > 0)
+                {
+                    book_file << GUESS_SEPARATOR;
+                }
+                book_file << (opening.second[c].empty() ? NO_GUESS : std::string_view(opening.second[c]));
+            }
+            book_file << "\n";
+        }
+        book_file.close();
+        if (!book_file)
+        {
+            std::error_code error;
+            std::filesystem::remove(temp_fp, error);
+            throw WordleSolverException("Could not write " + temp_fp);
+        }
+
+        ReplaceFile(temp_fp, self.book_fp);
+    }
+};
+
+OpeningBook::OpeningBook() {}
+
+OpeningBook::OpeningBook(std::string_view book_fp) : book_fp(book_fp)
+{
+    Private::Load(*this);
+}
+
+bool OpeningBook::Find(const Dictionary &d, const AbstractRanker &r, bool hard_mode, Opening &opening) const
+{
+    auto key{Private::Key(d, r, hard_mode)};
+    std::lock_guard<std::mutex> lock(mutex);
+    auto itr{openings.find(key)};
+    if (itr == openings.end())
+    {
+        return false;
+    }
+    opening = itr->second;
+    return true;
+}
+
+void OpeningBook::Insert(const Dictionary &d, const AbstractRanker &r, bool hard_mode, const Opening &opening)
+{
+    auto key{Private::Key(d, r, hard_mode)};
+    std::lock_guard<std::mutex> lock(mutex);
+    openings[key] = opening;
+    if (book_fp.empty())
+    {
+        return;
+    }
+
+    // The opening is kept in memory either way, a book that cannot be saved
+    // only means later runs rank it again
+    try
+    {
+        Private::Save(*this);
+    }
+    catch (const WordleSolverException &)
+    {
+    }
+}
+
+size_t OpeningBook::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return openings.size();
+}
+
+std::string OpeningBook::GetDefaultFilePath(const std::string &dictionary_fp)
+{
+    std::filesystem::path book_path{dictionary_fp};
+    auto stem{book_path.stem().string()};
+    return book_path.replace_filename(stem + "-openings.tsv").string();
+}
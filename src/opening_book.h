@@ -0,0 +1,128 @@
+/*
+Header for OpeningBook.
+
+This file declares the OpeningBook class which stores the first two guesses
+a WordleSolver makes so they can be looked up instead of ranked.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <map>
+#include <mutex>
+#include "dictionary.h"
+#include "ranker.h"
+#include "feedback.h"
+
+/*
+Collection of precomputed openings.
+
+With a deterministic ranker (see AbstractRanker::IsDeterministic), the first
+guess a WordleSolver makes only depends on the dictionary, and the second
+only depends on the feedback on the first. So the first guess and the second
+guess for every feedback can be computed once and reused by every game. An
+opening is stored for a dictionary (by checksum and size), a ranker (by
+name and data checksum, see AbstractRanker::GetDataChecksum), and whether
+the solver is in hard mode.
+
+A book may be backed by a text file (one opening per line) that is loaded on
+construction and rewritten whenever an opening is added. The file only saves
+work, so failing to write it never fails adding an opening. A book can be
+shared by solvers on different threads.
+*/
+class OpeningBook
+{
+public:
+    // The first two guesses of a solver
+    struct Opening
+    {
+        // First guess
+        std::string first;
+
+        // second[c] is the second guess after receiving feedback code c (see
+        // EncodeFeedback) on first, empty if no word of the dictionary gives c
+        std::array<std::string, NUM_FEEDBACK_CODES> second;
+    };
+
+    // Creates an empty book that is only kept in memory.
+    OpeningBook();
+
+    /*
+    Creates a book backed by a file.
+
+    Parameters:
+        book_fp: Path to the book file. If it exists, its openings are
+                 loaded. Otherwise, it is created when an opening is added.
+
+    Throws:
+        WordleSolverException if book_fp exists but cannot be read or is not
+        a valid book.
+    */
+    OpeningBook(std::string_view book_fp);
+
+    /*
+    Finds an opening.
+
+    Parameters:
+        d: Dictionary the solver uses.
+        r: The solver's ranker.
+        hard_mode: Whether the solver is in hard mode.
+        opening: Will store the opening if it is found.
+
+    Returns:
+        true if the book has the opening, false otherwise.
+    */
+    bool Find(const Dictionary &d, const AbstractRanker &r, bool hard_mode, Opening &opening) const;
+
+    /*
+    Adds (or replaces) an opening, saving the book if it is backed by a file.
+
+    If the book file cannot be written, the opening is still added to the
+    book in memory.
+
+    Parameters:
+        d: Dictionary the solver uses.
+        r: The solver's ranker.
+        hard_mode: Whether the solver is in hard mode.
+        opening: Opening to add.
+    */
+    void Insert(const Dictionary &d, const AbstractRanker &r, bool hard_mode, const Opening &opening);
+
+    // Gets the number of openings in the book.
+    size_t Size() const;
+
+    /*
+    Gets the default path of the book file for a dictionary.
+
+    Parameters:
+        dictionary_fp: Path to a dictionary file.
+
+    Returns:
+        Path with the extension replaced, e.g. "a.txt" -> "a-openings.tsv".
+    */
+    static std::string GetDefaultFilePath(const std::string &dictionary_fp);
+
+private:
+    /*
+    Inner class that holds private helper functions of OpeningBook. See
+    https://stackoverflow.com/a/28734794.
+    */
+    class Private;
+
+    // Path to the book file (empty if the book is only kept in memory)
+    std::string book_fp;
+
+    // Guards openings (and the book file)
+    mutable std::mutex mutex;
+
+    // Openings by key (dictionary checksum, size, hard mode, ranker data checksum, and ranker name)
+    std::map<std::string, Opening> openings;
+};
+
+#endif
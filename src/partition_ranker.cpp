@@ -0,0 +1,236 @@
+// Implementation of partition_ranker.h
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "partition_ranker.h"
+#include <atomic>
+#include <climits>
+#include <string>
+#include <algorithm>
+
+class PartitionRanker::Private
+{
+public:
+    // Number of answers between checks for early cutoff
+    static const size_t CUTOFF_BLOCK{256};
+
+    // Number of histograms the feedback codes are spread over, so consecutive
+    // increments of the same code do not wait on each other
+    static const size_t NUM_HISTOGRAMS{4};
+
+    /*
+    Ranks a guess by the groups its feedback splits the answers into.
+
+    The feedback comes from the FeedbackMatrix when it can be used and guess_id
+    is known, otherwise it is computed from the packed words.
+
+    If best is not nullptr, every CUTOFF_BLOCK answers the rank of the groups
+    counted so far is checked against *best. Since PartitionRank never
+    decreases as a group grows, once it is worse than *best the guess cannot
+    reach *best and the rank so far is returned.
+    */
+    static int Rank(const PartitionRanker &self, uint32_t guess_code, uint32_t guess_id, const std::atomic<int> *best)
+    {
+        if (self.use_matrix && guess_id != Word::NO_ID)
+        {
+            auto row{self.matrix->Row(guess_id)};
+            const auto &answer_ids{self.answer_ids};
+            return Rank(self, [row, &answer_ids](size_t i)
+                        { return row[answer_ids[i]]; },
+                        best);
+        }
+
+        const auto &answers{self.answers};
+        return Rank(self, [guess_code, &answers](size_t i)
+                    { return GetFeedbackCode(guess_code, answers[i]); },
+                    best);
+    }
+
+    // Implements Rank with feedback(i) giving the feedback code of answer i
+    template <typename Functor>
+    static int Rank(const PartitionRanker &self, const Functor &feedback, const std::atomic<int> *best)
+    {
+        auto n{self.answers.size()};
+        uint32_t histograms[NUM_HISTOGRAMS][NUM_FEEDBACK_CODES]{};
+        size_t i{0};
+        while (i < n)
+        {
+            auto block_end{std::min(n, i + CUTOFF_BLOCK)};
+            for (; i + NUM_HISTOGRAMS <= block_end; i += NUM_HISTOGRAMS)
+            {
+                for (size_t h{0}; h < NUM_HISTOGRAMS; h++)
+                {
+                    histograms[h][feedback(i + h)]++;
+                }
+            }
+            for (; i < block_end; i++)
+            {
+                histograms[0][feedback(i)]++;
+            }
+
+            if (best != nullptr && i < n)
+            {
+                auto rank{PartitionRank(self, histograms)};
+                if (rank > best->load(std::memory_order_relaxed))
+                {
+                    return rank;
+                }
+            }
+        }
+
+        return PartitionRank(self, histograms);
+    }
+
+    // Merges the histograms into the group sizes and ranks them
+    static int PartitionRank(const PartitionRanker &self, const uint32_t (&histograms)[NUM_HISTOGRAMS][NUM_FEEDBACK_CODES])
+    {
+        uint32_t sizes[NUM_FEEDBACK_CODES];
+        for (size_t code{0}; code < NUM_FEEDBACK_CODES; code++)
+        {
+            sizes[code] = 0;
+            for (size_t h{0}; h < NUM_HISTOGRAMS; h++)
+            {
+                sizes[code] += histograms[h][code];
+            }
+        }
+        return self.PartitionRank(sizes);
+    }
+
+    // Ranks a batch of words in the pool (unless on a pool worker), stopping
+    // early on words that cannot be the best if cutoff is true
+    static void RankAll(const PartitionRanker &self, std::span<const Word> words, std::span<int> ranks, bool cutoff)
+    {
+        // Lowest rank computed so far (shared by the threads for early cutoff)
+        std::atomic<int> best{INT_MAX};
+        auto cutoff_best{cutoff ? &best : nullptr};
+
+        auto rank_word{[&self, &words, &ranks, &best, cutoff_best](size_t i, size_t /*worker*/)
+                       {
+                           ranks[i] = Rank(self, words[i].code, words[i].id, cutoff_best);
+                           UpdateBest(best, ranks[i]);
+                       }};
+
+        if (self.pool && self.pool->Size() > 1 && !ThreadPool::IsWorkerThread())
+        {
+            self.pool->ParallelFor(words.size(), rank_word);
+            return;
+        }
+        for (size_t i{0}; i < words.size(); i++)
+        {
+            rank_word(i, 0);
+        }
+    }
+
+    // Lowers best to rank if it is lower
+    static void UpdateBest(std::atomic<int> &best, int rank)
+    {
+        auto current{best.load(std::memory_order_relaxed)};
+        while (rank < current && !best.compare_exchange_weak(current, rank, std::memory_order_relaxed))
+        {
+        }
+    }
+};
+
+PartitionRanker::PartitionRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff) : AbstractRanker(name), num_threads(num_threads), early_cutoff(early_cutoff), matrix(m), dictionary(nullptr), use_matrix(false) {}
+
+PartitionRanker::PartitionRanker(const PartitionRanker &other) : AbstractRanker(other), num_threads(other.num_threads), early_cutoff(other.early_cutoff), answers(other.answers), matrix(other.matrix), dictionary(other.dictionary), use_matrix(other.use_matrix), answer_ids(other.answer_ids) {}
+
+void PartitionRanker::SetUp(const EligibleWords &eligible, unsigned short /*guess*/, std::string_view /*feedback*/)
+{
+    // The matrix can only be used if it was built for the eligible words' dictionary
+    dictionary = eligible.GetDictionary();
+    use_matrix = matrix && dictionary != nullptr && matrix->GetDictionary().GetChecksum() == dictionary->GetChecksum() && matrix->GetDictionary().Size() == dictionary->Size();
+    if (use_matrix)
+    {
+        answer_ids = eligible.GetIds();
+    }
+
+    if (eligible.IsInMemory())
+    {
+        answers = eligible.GetCodes();
+    }
+    else
+    {
+        answers.clear();
+        eligible.ForEach([this](std::string_view word)
+                         { answers.push_back(EncodeWord(word)); });
+    }
+
+    // A ranker set up on a pool worker ranks serially (see RankAll), so it does
+    // not start a pool of its own per worker
+    if (!pool && num_threads != 1 && !ThreadPool::IsWorkerThread())
+    {
+        pool = std::make_shared<ThreadPool>(num_threads);
+    }
+}
+
+int PartitionRanker::Rank(std::string_view word) const
+{
+    uint32_t id{Word::NO_ID};
+    if (use_matrix)
+    {
+        dictionary->Find(word, id);
+    }
+    return Private::Rank(*this, EncodeWord(word), id, nullptr);
+}
+
+void PartitionRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    Private::RankAll(*this, words, ranks, early_cutoff);
+}
+
+void PartitionRanker::RankAllExact(std::span<const Word> words, std::span<int> ranks) const
+{
+    Private::RankAll(*this, words, ranks, false);
+}
+
+std::string PartitionRanker::GetDebugInfo() const
+{
+    return "Possible solutions: " + std::to_string(answers.size()) + "\n";
+}
+
+size_t PartitionRanker::GetNumAnswers() const
+{
+    return answers.size();
+}
+
+MinimaxRanker::MinimaxRanker() : MinimaxRanker("MinimaxRanker()", nullptr, 0, false) {}
+MinimaxRanker::MinimaxRanker(size_t num_threads, bool early_cutoff) : MinimaxRanker("MinimaxRanker(" + std::to_string(early_cutoff) + ")", nullptr, num_threads, early_cutoff) {}
+MinimaxRanker::MinimaxRanker(std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff) : MinimaxRanker("MinimaxRanker(FeedbackMatrix," + std::to_string(early_cutoff) + ")", m, num_threads, early_cutoff) {}
+MinimaxRanker::MinimaxRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff) : PartitionRanker(name, m, num_threads, early_cutoff) {}
+
+std::unique_ptr<AbstractRanker> MinimaxRanker::Clone() const
+{
+    return std::make_unique<MinimaxRanker>(*this);
+}
+
+int MinimaxRanker::PartitionRank(const uint32_t (&sizes)[NUM_FEEDBACK_CODES]) const
+{
+    return static_cast<int>(*std::max_element(sizes, sizes + NUM_FEEDBACK_CODES));
+}
+
+ExpectedSizeRanker::ExpectedSizeRanker() : ExpectedSizeRanker("ExpectedSizeRanker()", nullptr, 0, false) {}
+ExpectedSizeRanker::ExpectedSizeRanker(size_t num_threads, bool early_cutoff) : ExpectedSizeRanker("ExpectedSizeRanker(" + std::to_string(early_cutoff) + ")", nullptr, num_threads, early_cutoff) {}
+ExpectedSizeRanker::ExpectedSizeRanker(std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff) : ExpectedSizeRanker("ExpectedSizeRanker(FeedbackMatrix," + std::to_string(early_cutoff) + ")", m, num_threads, early_cutoff) {}
+ExpectedSizeRanker::ExpectedSizeRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff) : PartitionRanker(name, m, num_threads, early_cutoff) {}
+
+std::unique_ptr<AbstractRanker> ExpectedSizeRanker::Clone() const
+{
+    return std::make_unique<ExpectedSizeRanker>(*this);
+}
+
+int ExpectedSizeRanker::PartitionRank(const uint32_t (&sizes)[NUM_FEEDBACK_CODES]) const
+{
+    // Sum of squares is at most n * n, kept exact in 64 bits before dividing by n
+    uint64_t sum_squares{0};
+    for (auto c : sizes)
+    {
+        sum_squares += static_cast<uint64_t>(c) * c;
+    }
+    auto n{GetNumAnswers()};
+    if (n == 0)
+    {
+        return 0;
+    }
+    return static_cast<int>((sum_squares * RANK_SCALE + n / 2) / n);
+}
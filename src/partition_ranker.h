@@ -0,0 +1,278 @@
+/*
+Header for rankers that rank guesses by how they partition the eligible words.
+
+This file includes PartitionRanker (the abstract base of these rankers),
+MinimaxRanker, and ExpectedSizeRanker. EntropyRanker (see entropy_ranker.h)
+is also a PartitionRanker.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef PARTITION_RANKER_H
+#define PARTITION_RANKER_H
+
+#include "ranker.h"
+#include "thread_pool.h"
+#include "feedback_matrix.h"
+#include "feedback.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+/*
+Abstract class of rankers that rank a guess by the feedback it would receive.
+
+Every eligible word is treated as a possible solution. For a guess, the
+eligible words are split into (up to 243) groups by the feedback the guess
+would receive if each were the solution. Derived classes rank a guess from
+the sizes of these groups (see PartitionRank).
+
+Ranking every eligible word this way takes time proportional to the square
+of the number of eligible words, so RankAll spreads the words over a
+ThreadPool and (optionally) stops working on a word as soon as it is known
+that it cannot beat the best word found so far. The feedback can also be
+looked up in a FeedbackMatrix rather than computed.
+*/
+class PartitionRanker : public AbstractRanker
+{
+public:
+    /*
+    Sets up a PartitionRanker to rank based on the currently eligible words.
+
+    The eligible words are stored (as packed codes) as the possible solutions.
+
+    Parameters:
+        eligible: The remaining eligible words.
+        guess: What guess this set up will be for (1...6).
+        feedback: Feedback on previous guess (if guess = 1, this parameter should not
+                  be used by SetUp, it will be set to some placeholder when called).
+    */
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
+
+    /*
+    Ranks a word from the groups its feedback splits the eligible words into.
+
+    Parameters:
+        word: Word to rank.
+
+    Returns:
+        PartitionRank of the group sizes. Never uses early cutoff.
+    */
+    virtual int Rank(std::string_view word) const override;
+
+    // Ranks a batch of words in parallel (see AbstractRanker::RankAll and PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool)).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Ranks a batch of words in parallel without early cutoff (see AbstractRanker::RankAllExact).
+    virtual void RankAllExact(std::span<const Word> words, std::span<int> ranks) const override;
+
+    /*
+    Gets debug information on this ranker.
+
+    Returns:
+        The number of possible solutions seen by the most recent SetUp.
+    */
+    virtual std::string GetDebugInfo() const override;
+
+protected:
+    /*
+    Constructs a PartitionRanker.
+
+    Parameters:
+        name: Name for the ranker
+        m: Precomputed feedback of the dictionary the solver uses (nullptr to
+           always compute the feedback). Looking the feedback up is much faster
+           than computing it. The matrix is only used when the eligible words
+           are in memory and come from the dictionary the matrix was built for.
+        num_threads: Threads RankAll uses (0 for one per hardware thread, 1 to
+                     rank on the calling thread only). RankAll always ranks
+                     on the calling thread when it is a ThreadPool worker
+                     (e.g. for clones used by a parallel GridEvaluate or
+                     Strategy build), whose pool already uses every core.
+                     The ranks do not depend on it, so derived classes leave
+                     it out of their names (which key the OpeningBook and
+                     the guess caches).
+        early_cutoff: If true, RankAll stops computing the groups of a word
+                      once it cannot match the best word found so far and gives
+                      it the rank of the groups counted so far (which is still
+                      worse than the best rank). The best words keep their exact
+                      ranks, but the others do not, so this is only worth
+                      enabling when just the best word is used (e.g. a
+                      WordleSolver choosing one guess). RankAllExact never
+                      uses it, which is what rankers combining these ranks
+                      with others (e.g. DuplicateRanker) call.
+    */
+    PartitionRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff);
+
+    /*
+    Copies a PartitionRanker except for its ThreadPool.
+
+    The copy creates its own pool (in SetUp) so its RankAll does not wait on
+    this one's, unless it is set up on a ThreadPool worker (see
+    ThreadPool::IsWorkerThread) where it ranks serially and creates no pool.
+    This is what derived classes' Clone uses.
+    */
+    PartitionRanker(const PartitionRanker &other);
+
+    /*
+    Computes the rank of a guess from the sizes of the groups it splits the
+    possible solutions into.
+
+    For early cutoff, this is also called on the sizes of the groups of only
+    some of the possible solutions. So, the rank must never decrease when a
+    group grows.
+
+    Parameters:
+        sizes: sizes[c] is the number of possible solutions that give feedback
+               code c (see GetFeedbackCode).
+
+    Returns:
+        Rank of the guess.
+    */
+    virtual int PartitionRank(const uint32_t (&sizes)[NUM_FEEDBACK_CODES]) const = 0;
+
+    // Gets the number of possible solutions seen by the most recent SetUp.
+    size_t GetNumAnswers() const;
+
+private:
+    /*
+    Inner class that holds private helper functions of PartitionRanker. See
+    https://stackoverflow.com/a/28734794.
+    */
+    class Private;
+
+    // Threads used by RankAll (0 for one per hardware thread)
+    size_t num_threads;
+
+    // Whether RankAll stops early on words that cannot be the best
+    bool early_cutoff;
+
+    // Packed codes of the eligible words (the possible solutions)
+    std::vector<uint32_t> answers;
+
+    // Optional precomputed feedback (nullptr if not used)
+    std::shared_ptr<const FeedbackMatrix> matrix;
+
+    // Dictionary of the eligible words seen by SetUp (nullptr when file-backed)
+    const Dictionary *dictionary;
+
+    // Whether matrix can be used with the eligible words seen by SetUp
+    bool use_matrix;
+
+    // Ids of the eligible words (only set when use_matrix)
+    std::vector<uint32_t> answer_ids;
+
+    // Pool used by RankAll, created by SetUp (off ThreadPool workers) so
+    // clones each get their own
+    std::shared_ptr<ThreadPool> pool;
+};
+
+/*
+Class that ranks words by the size of the largest group of their feedback.
+
+This minimizes the number of eligible words left in the worst case.
+*/
+class MinimaxRanker : public PartitionRanker
+{
+public:
+    /*
+    Constructs a MinimaxRanker that uses every hardware thread without early cutoff.
+    */
+    MinimaxRanker();
+
+    /*
+    Constructs a MinimaxRanker.
+
+    Parameters:
+        num_threads: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        early_cutoff: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+    */
+    MinimaxRanker(size_t num_threads, bool early_cutoff);
+
+    /*
+    Overloaded version of MinimaxRanker(size_t,bool) that looks feedback up in a FeedbackMatrix.
+
+    Parameters:
+        m: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        num_threads: See MinimaxRanker(size_t,bool).
+        early_cutoff: See MinimaxRanker(size_t,bool).
+    */
+    MinimaxRanker(std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff);
+
+    /*
+    Overloaded version of MinimaxRanker(std::shared_ptr<const FeedbackMatrix>,size_t,bool) that allows name specification.
+
+    Parameters:
+        name: Name for the ranker
+        m: See MinimaxRanker(std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        num_threads: See MinimaxRanker(size_t,bool).
+        early_cutoff: See MinimaxRanker(size_t,bool).
+    */
+    MinimaxRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff);
+
+    // Returns a copy of this ranker with its own ThreadPool (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+protected:
+    // Ranks by the largest group size.
+    virtual int PartitionRank(const uint32_t (&sizes)[NUM_FEEDBACK_CODES]) const override;
+};
+
+/*
+Class that ranks words by the expected number of eligible words left after them.
+
+If each eligible word is equally likely to be the solution, the solution is
+in a group of size c with probability c / n, so the expected number of
+eligible words left is the sum of c * c / n over the groups.
+*/
+class ExpectedSizeRanker : public PartitionRanker
+{
+public:
+    /*
+    Constructs an ExpectedSizeRanker that uses every hardware thread without early cutoff.
+    */
+    ExpectedSizeRanker();
+
+    /*
+    Constructs an ExpectedSizeRanker.
+
+    Parameters:
+        num_threads: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        early_cutoff: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+    */
+    ExpectedSizeRanker(size_t num_threads, bool early_cutoff);
+
+    /*
+    Overloaded version of ExpectedSizeRanker(size_t,bool) that looks feedback up in a FeedbackMatrix.
+
+    Parameters:
+        m: See PartitionRanker(std::string_view,std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        num_threads: See ExpectedSizeRanker(size_t,bool).
+        early_cutoff: See ExpectedSizeRanker(size_t,bool).
+    */
+    ExpectedSizeRanker(std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff);
+
+    /*
+    Overloaded version of ExpectedSizeRanker(std::shared_ptr<const FeedbackMatrix>,size_t,bool) that allows name specification.
+
+    Parameters:
+        name: Name for the ranker
+        m: See ExpectedSizeRanker(std::shared_ptr<const FeedbackMatrix>,size_t,bool).
+        num_threads: See ExpectedSizeRanker(size_t,bool).
+        early_cutoff: See ExpectedSizeRanker(size_t,bool).
+    */
+    ExpectedSizeRanker(std::string_view name, std::shared_ptr<const FeedbackMatrix> m, size_t num_threads, bool early_cutoff);
+
+    // Returns a copy of this ranker with its own ThreadPool (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Multiplier applied to the expected size to get an integer rank
+    static const int RANK_SCALE{1000};
+
+protected:
+    // Ranks by the expected size times RANK_SCALE rounded to an integer.
+    virtual int PartitionRank(const uint32_t (&sizes)[NUM_FEEDBACK_CODES]) const override;
+};
+
+#endif
@@ -0,0 +1,142 @@
+// Implementation of PopularityRanking
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "popularity_ranking.h"
+#include "misc.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+
+class PopularityRanking::Private
+{
+public:
+    // Rankings currently in use by file path (expired once no ranker uses them)
+    static std::mutex loaded_mutex;
+    static std::unordered_map<std::string, std::weak_ptr<const PopularityRanking>> loaded;
+
+    // Reads the ranks in the mapped frequency file. Each line is parsed in
+    // place and the words are kept as views into the mapping
+    static void Read(PopularityRanking &self)
+    {
+        auto begin{self.file->Data()};
+        auto end{begin + self.file->Size()};
+        self.ranks.reserve(std::count(begin, end, '\n') + 1);
+
+        // FNV-1a (see Dictionary::GetChecksum)
+        self.checksum = 14695981039346656037ull;
+        for (auto c{begin}; c < end; c++)
+        {
+            self.checksum = (self.checksum ^ static_cast<unsigned char>(*c)) * 1099511628211ull;
+        }
+
+        int curr_rank{0};
+        long curr_count{LONG_MAX};
+        for (auto line{begin}; line < end;)
+        {
+            auto line_end{std::find(line, end, '\n')};
+            auto next{line_end + (line_end < end)};
+            if (line_end > line && line_end[-1] == '\r')
+            {
+                line_end--;
+            }
+            if (line_end == line)
+            {
+                line = next;
+                continue;
+            }
+
+            auto comma{std::find(line, line_end, ',')};
+            long count{0};
+            auto [count_end, error]{std::from_chars(comma + (comma < line_end), line_end, count)};
+            if (comma == line_end || error != std::errc{} || count_end != line_end)
+            {
+                throw WordleSolverException("Invalid line in " + self.freq_fp + ": " + std::string(line, line_end));
+            }
+
+            if (count < curr_count)
+            {
+                curr_rank++;
+                curr_count = count;
+            }
+            self.ranks.insert_or_assign(std::string_view(line, comma - line), curr_rank);
+            line = next;
+        }
+    }
+};
+
+std::mutex PopularityRanking::Private::loaded_mutex;
+std::unordered_map<std::string, std::weak_ptr<const PopularityRanking>> PopularityRanking::Private::loaded;
+
+PopularityRanking::PopularityRanking(const std::string &freq_fp) : freq_fp(freq_fp), file(std::make_unique<MappedFile>(freq_fp)), checksum(0)
+{
+    Private::Read(*this);
+}
+
+std::shared_ptr<const PopularityRanking> PopularityRanking::Load(const std::string &freq_fp)
+{
+    std::lock_guard<std::mutex> lock(Private::loaded_mutex);
+    auto &entry{Private::loaded[freq_fp]};
+    auto ranking{entry.lock()};
+    if (ranking == nullptr)
+    {
+        ranking = std::make_shared<const PopularityRanking>(freq_fp);
+        entry = ranking;
+    }
+    return ranking;
+}
+
+const std::string &PopularityRanking::GetFilePath() const
+{
+    return freq_fp;
+}
+
+uint64_t PopularityRanking::GetChecksum() const
+{
+    return checksum;
+}
+
+size_t PopularityRanking::Size() const
+{
+    return ranks.size();
+}
+
+int PopularityRanking::GetUnrankedRank() const
+{
+    return static_cast<int>(ranks.size() + 1);
+}
+
+int PopularityRanking::Find(std::string_view word) const
+{
+    auto p{ranks.find(word)};
+    return (p == ranks.end()) ? GetUnrankedRank() : p->second;
+}
+
+std::shared_ptr<const std::vector<int>> PopularityRanking::GetRanksById(const Dictionary &d) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &ranks_by_id{ranks_by_dictionary[d.GetChecksum()]};
+    if (ranks_by_id == nullptr)
+    {
+        auto compiled{d.GetPopularityRanks()};
+        if (!compiled.empty() && d.GetPopularityChecksum() == checksum)
+        {
+            ranks_by_id = std::make_shared<const std::vector<int>>(compiled.begin(), compiled.end());
+        }
+        else
+        {
+            auto resolved{std::make_shared<std::vector<int>>(d.Size())};
+            for (uint32_t id{0}; id < d.Size(); id++)
+            {
+                (*resolved)[id] = Find(d[id]);
+            }
+            ranks_by_id = resolved;
+        }
+    }
+    return ranks_by_id;
+}
+
+const WordRanks &PopularityRanking::GetRanks() const
+{
+    return ranks;
+}
@@ -0,0 +1,140 @@
+/*
+Header for PopularityRanking.
+
+This file declares the PopularityRanking class which holds the popularity
+ranks read from a frequency file, shared by every ranker that uses the file.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef POPULARITY_RANKING_H
+#define POPULARITY_RANKING_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "dictionary.h"
+#include "mapped_file.h"
+
+// Popularity rank of each word in a frequency file
+// (the words are views into the mapped file)
+using WordRanks = std::unordered_map<std::string_view, int>;
+
+/*
+Popularity ranks of words read from a frequency file.
+
+The file is memory-mapped (see MappedFile) and parsed in place, the words
+are not copied out of the mapping. A ranking is never modified after it is
+loaded (other than to remember the ranks it has resolved for dictionaries),
+so it is shared by every ranker that loads the same file and by their clones. Ranks can be looked up by word or
+resolved once for every word of a Dictionary into an array indexed by id, so
+ranking a dictionary word is a single load.
+*/
+class PopularityRanking
+{
+public:
+    /*
+    Loads a ranking from a frequency file.
+
+    Parameters:
+        freq_fp: Filepath to CSV file with 2 columns where the first column
+                 is a list of 5 letter words ordered in descending popularity
+                 and the second column is the counts. Words with equal
+                 frequency have equal rank (starting from 1).
+
+    Throws:
+        WordleSolverException if freq_fp cannot be opened or holds a line
+        that is not a word followed by a count.
+    */
+    PopularityRanking(const std::string &freq_fp);
+
+    /*
+    Gets the ranking of a frequency file, loading it only if no ranking of the
+    file is currently in use.
+
+    Parameters:
+        freq_fp: Filepath to a frequency CSV file (see PopularityRanking()).
+
+    Returns:
+        The ranking, shared with every other caller that loaded freq_fp while
+        it was in use.
+
+    Throws:
+        WordleSolverException if freq_fp cannot be loaded (see PopularityRanking()).
+    */
+    static std::shared_ptr<const PopularityRanking> Load(const std::string &freq_fp);
+
+    // Path of the file the ranking was loaded from.
+    const std::string &GetFilePath() const;
+
+    // Number of words with a popularity rank.
+    size_t Size() const;
+
+    // Checksum of the contents of the file (64-bit FNV-1a hash).
+    uint64_t GetChecksum() const;
+
+    // Rank given to words that are not in the file (higher than every rank in the file).
+    int GetUnrankedRank() const;
+
+    /*
+    Finds the popularity rank of a word.
+
+    Parameters:
+        word: Word to find.
+
+    Returns:
+        The rank of word, GetUnrankedRank() if it is not in the file.
+    */
+    int Find(std::string_view word) const;
+
+    /*
+    Resolves the popularity rank of every word in a dictionary.
+
+    The ranks are only resolved the first time a dictionary with the same
+    words (see Dictionary::GetChecksum) is passed, later calls share them.
+    If the dictionary was compiled with the ranks of this file (see
+    Dictionary::Compile), they are taken from it instead of looked up.
+
+    Parameters:
+        d: A Dictionary.
+
+    Returns:
+        The ranks indexed by word id (see Find).
+    */
+    std::shared_ptr<const std::vector<int>> GetRanksById(const Dictionary &d) const;
+
+    // Popularity ranks of the words in the file.
+    const WordRanks &GetRanks() const;
+
+private:
+    /*
+    Inner class that holds private helper functions of PopularityRanking. See
+    https://stackoverflow.com/a/28734794.
+    */
+    class Private;
+
+    // Path of the frequency file
+    std::string freq_fp;
+
+    // Contents of the frequency file, which the words in ranks point into
+    std::unique_ptr<MappedFile> file;
+
+    // Checksum of the contents of the frequency file
+    uint64_t checksum;
+
+    // Popularity rank of each word in the file
+    WordRanks ranks;
+
+    // Guards ranks_by_dictionary
+    mutable std::mutex mutex;
+
+    // Ranks resolved for dictionaries, by dictionary checksum
+    mutable std::unordered_map<uint64_t, std::shared_ptr<const std::vector<int>>> ranks_by_dictionary;
+};
+
+#endif
@@ -3,52 +3,47 @@
 // Date: Summer 2022
 
 #include "position_ranker.h"
-#include <fstream>
 #include "misc.h"
 
 PositionRanker::PositionRanker() : AbstractRanker("PositionRanker()") {}
 PositionRanker::PositionRanker(std::string_view name) : AbstractRanker(name) {}
-void PositionRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void PositionRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
-    std::ifstream eligible_file(eligible_fp, std::ios_base::in);
-    if (!eligible_file.is_open())
+    // Position counts are computed once per set of eligible words and shared
+    const auto &statistics{eligible.GetStatistics()};
+    for (unsigned short i{0}; i < WORD_LENGTH; i++)
     {
-        throw WordleSolverException("Could not open " + eligible_fp + " for reading");
+        word_counts[i] = statistics.GetPositionCounts(i);
+        CountsToRanks(word_counts[i], rankings[i], letters[i]);
     }
+}
 
-    // Stores the current word read from file
-    std::string word;
-
-    // Read over each letter in each eligible word and increase its count after resetting counts.
-    for (auto m : word_counts)
+int PositionRanker::Rank(std::string_view word) const
+{
+    int rank{0};
+    for (unsigned short i{0}; i < WORD_LENGTH; i++)
     {
-        m.clear();
+        rank += rankings[i][word[i] - 'a'];
     }
+    return rank;
+}
 
-    while (eligible_file.good())
+void PositionRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    for (size_t i{0}; i < words.size(); i++)
     {
-        std::getline(eligible_file, word);
-        for (auto i{0}; i < word.size(); i++)
+        int rank{0};
+        for (unsigned short j{0}; j < WORD_LENGTH; j++)
         {
-            word_counts[i][word[i]]++;
+            rank += rankings[j][CodeLetter(words[i].code, j)];
         }
-    }
-    eligible_file.close();
-
-    for (auto i{0}; i < 5; i++)
-    {
-        CountsToRanks(word_counts[i], rankings[i], letters[i]);
+        ranks[i] = rank;
     }
 }
 
-int PositionRanker::Rank(std::string_view word) const
+std::unique_ptr<AbstractRanker> PositionRanker::Clone() const
 {
-    int rank{0};
-    for (auto i{0}; i < word.size(); i++)
-    {
-        rank += rankings[i].find(word[i])->second;
-    }
-    return rank;
+    return std::make_unique<PositionRanker>(*this);
 }
 
 std::string PositionRanker::GetDebugInfo() const
@@ -63,11 +58,11 @@ std::string PositionRanker::GetDebugInfo() const
 
         for (auto l : letters[i])
         {
-            debug_info += l;
+            debug_info += static_cast<char>('a' + l);
             debug_info += ": ";
-            debug_info += std::to_string(rankings[i].find(l)->second);
+            debug_info += std::to_string(rankings[i][l]);
             debug_info += " ";
-            debug_info += std::to_string(word_counts[i].find(l)->second);
+            debug_info += std::to_string(word_counts[i][l]);
             debug_info += "\n";
         }
     }
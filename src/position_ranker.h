@@ -9,8 +9,8 @@ Date: Summer 2022
 #define POSITION_RANKER_H
 
 #include "ranker.h"
-#include <unordered_map>
 #include <vector>
+#include <array>
 
 /*
 Class that ranks words based on the letters at each position in the word.
@@ -45,12 +45,12 @@ public:
     the 5 positions in the eligible words (not in the original dictionary).
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes the rank of a word as the sum of the ranks of each letter at their indices.
@@ -65,6 +65,12 @@ public:
     */
     virtual int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
     /*
     Gets a string with letters ranking and count information for each of 5 indices.
 
@@ -77,19 +83,19 @@ public:
     virtual std::string GetDebugInfo() const override;
 
 private:
-    // word_counts[i] is a map of each letter to the number of
-    // words it occurs in at position i in the eligible words
-    std::unordered_map<char, size_t> word_counts[5];
+    // word_counts[i][c] is the number of words with letter c (as 0-25)
+    // at position i in the eligible words
+    std::array<size_t, NUM_LETTERS> word_counts[WORD_LENGTH];
 
-    // rankings[i] is a map of each letter to its rank for
-    // occurring at position i in the eligible words (derived
-    // from word_counts[i] in SetUp)
-    std::unordered_map<char, int> rankings[5];
+    // rankings[i][c] is the rank of letter c (as 0-25) for occurring at
+    // position i in the eligible words (derived from word_counts[i] in SetUp,
+    // 0 for letters that do not occur there)
+    std::array<int, NUM_LETTERS> rankings[WORD_LENGTH];
 
-    // letters[i] is a vector of the letters at position i
+    // letters[i] is a vector of the letters (as 0-25) at position i
     // stored according to ascending rank (derived from
     // word_counts[i] in SetUp)
-    std::vector<char> letters[5];
+    std::vector<unsigned short> letters[WORD_LENGTH];
 };
 
 #endif
\ No newline at end of file
@@ -6,27 +6,40 @@
 #include <ctime>
 #include <string>
 
-RandomRanker::RandomRanker(): AbstractRanker("RandomRanker()")
+RandomRanker::RandomRanker() : AbstractRanker("RandomRanker()"), seed(static_cast<unsigned int>(time(nullptr))) {}
+
+RandomRanker::RandomRanker(unsigned int seed) : RandomRanker("RandomRanker(" + std::to_string(seed) + ")", seed) {}
+
+RandomRanker::RandomRanker(std::string_view name, unsigned int seed) : AbstractRanker(name), seed(seed), engine(seed) {}
+
+void RandomRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
-    srand(time(nullptr));
+    // Start every game from the same point in the random sequence
+    if (guess == 1)
+    {
+        engine.seed(seed);
+    }
 }
 
-RandomRanker::RandomRanker(unsigned int seed): AbstractRanker("RandomRanker(" + std::to_string(seed) + ")")
+int RandomRanker::Rank(std::string_view word) const
 {
-    srand(seed);
+    return static_cast<int>(engine());
 }
 
-RandomRanker::RandomRanker(std::string_view name, unsigned int seed): AbstractRanker(name)
+void RandomRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
 {
-    srand(seed);
+    for (size_t i{0}; i < words.size(); i++)
+    {
+        ranks[i] = static_cast<int>(engine());
+    }
 }
 
-void RandomRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+std::unique_ptr<AbstractRanker> RandomRanker::Clone() const
 {
-    // Have nothing to do
+    return std::make_unique<RandomRanker>(*this);
 }
 
-int RandomRanker::Rank(std::string_view word) const
+bool RandomRanker::IsDeterministic() const
 {
-    return rand();
-}
\ No newline at end of file
+    return false;
+}
@@ -13,6 +13,7 @@ Date: Summer 2022
 #define RANDOM_RANKER_H
 
 #include "ranker.h"
+#include <random>
 
 /*
 Class that ranks eligible words randomly.
@@ -21,6 +22,15 @@ This class derives AbstractRanker and provides random ranks for words. This
 class provides a simple implementation of AbstractRanker and also a useful
 baseline for comparing more advanced ranking schemes. This class cannot
 be derived from.
+
+Each RandomRanker has its own random engine which is reset to the seed at
+the start of every game (SetUp with guess = 1). Hence, the ranks in a game
+do not depend on which games were played before it or on other threads.
+
+Thread safety: unlike other rankers (see AbstractRanker::Clone), Rank and
+RankAll advance the random engine, so they must not be called concurrently
+on the same RandomRanker (or on a ranker built on it). Each thread should use
+its own clone.
 */
 class RandomRanker final : public AbstractRanker
 {
@@ -68,12 +78,12 @@ public:
     Sets up the RandomRanker for ranking.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Provides a random rank for a word.
@@ -82,10 +92,25 @@ public:
         word: Word to rank.
 
     Returns:
-        Random rank between 0 and RAND_MAX see
-        https://cplusplus.com/reference/cstdlib/RAND_MAX/.
+        Random rank between std::minstd_rand::min() and std::minstd_rand::max().
     */
     int Rank(std::string_view word) const override;
+
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a copy of this ranker (see AbstractRanker::Clone).
+    std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Returns false, the ranks are random (and only repeat when SetUp is called every guess).
+    bool IsDeterministic() const override;
+
+private:
+    // Seed the random engine is reset to at the start of each game
+    unsigned int seed;
+
+    // Random engine, mutable as Rank is const but advances the engine
+    mutable std::minstd_rand engine;
 };
 
 #endif
\ No newline at end of file
@@ -8,6 +8,19 @@ AbstractRanker::AbstractRanker(std::string_view n) : name(n) {}
 
 AbstractRanker::~AbstractRanker() {}
 
+void AbstractRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    for (size_t i{0}; i < words.size(); i++)
+    {
+        ranks[i] = Rank(words[i].text);
+    }
+}
+
+void AbstractRanker::RankAllExact(std::span<const Word> words, std::span<int> ranks) const
+{
+    RankAll(words, ranks);
+}
+
 std::string AbstractRanker::GetName() const
 {
     return name;
@@ -17,3 +30,13 @@ std::string AbstractRanker::GetDebugInfo() const
 {
     return "";
 }
+
+bool AbstractRanker::IsDeterministic() const
+{
+    return true;
+}
+
+uint64_t AbstractRanker::GetDataChecksum() const
+{
+    return 0;
+}
@@ -14,6 +14,10 @@ Date: Summer 2022
 
 #include <string_view>
 #include <string>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include "eligible_words.h"
 
 /*
 Abstract class that defines the necessary behavior of a ranking scheme.
@@ -40,12 +44,12 @@ public:
     up containers used by Rank, etc. See LetterRanker::SetUp for an example.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words (visit them with EligibleWords::ForEach).
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) = 0;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) = 0;
 
     /*
     Provides the ranking for a word for a certain guess.
@@ -53,7 +57,8 @@ public:
     This function calculates the rank for a word. A rank can be any integer.
     WordleSolver will choose the eligible word w for guess g where Rank(w, g)
     is the lowest. It is assumed w was seen in the most recent call to SetUp
-    which also received g.
+    which also received g, unless the solver is not in hard mode (see
+    WordleSolver::SetHardMode) where w can be any word of the dictionary.
 
     Parameters:
         word: Word to rank.
@@ -63,6 +68,61 @@ public:
     */
     virtual int Rank(std::string_view word) const = 0;
 
+    /*
+    Provides the rankings of a batch of words.
+
+    This is equivalent to calling Rank on each word in order and is what
+    WordleSolver uses. The default implementation does exactly that. Derived
+    classes override it to rank the whole batch in one loop (and, for rankers
+    built on another AbstractRanker, to make one call to the passed ranker's
+    RankAll rather than one call per word).
+
+    Parameters:
+        words: Words to rank (see Rank for which words can be ranked).
+        ranks: Will store the rank of words[i] in ranks[i], must be the same
+               size as words.
+    */
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const;
+
+    /*
+    Provides the exact rankings of a batch of words.
+
+    RankAll may only give the lowest ranks exactly (e.g. PartitionRanker with
+    early cutoff), which is all WordleSolver needs to pick one guess. Callers
+    that use the other ranks as well (rankers built on another AbstractRanker,
+    WordleSolver::GuessCandidates with more than one candidate) call this
+    instead. The default implementation calls RankAll.
+
+    Parameters:
+        words: See RankAll.
+        ranks: See RankAll.
+    */
+    virtual void RankAllExact(std::span<const Word> words, std::span<int> ranks) const;
+
+    /*
+    Creates a copy of the ranker that shares no mutable state with it.
+
+    A ranker keeps the statistics computed by SetUp between calls to Rank, so
+    one ranker cannot be used by two solvers at the same time. A clone can be
+    used by another solver, e.g. on another thread. Rankers that are built on
+    another AbstractRanker (e.g. DuplicateRanker) clone it as well so the whole
+    chain is copied. Data that is only read after construction (e.g. the
+    popularity ranking of WordFrequencyRanker) may be shared with the clone.
+
+    Thread safety: SetUp must not run concurrently with any other call on the
+    same ranker (or on a ranker built on it). Once SetUp has returned, Rank,
+    RankAll, GetName and GetDebugInfo may be called concurrently, unless a
+    derived class documents otherwise (e.g. RandomRanker, whose Rank advances
+    a random engine, so each thread needs its own clone). Rankers used by
+    different threads must not share any part of their chain, so two chains
+    built on the same ranker (e.g. r41 in main.cpp) should each be cloned
+    before being used concurrently. Clone itself only reads the ranker.
+
+    Returns:
+        The copy.
+    */
+    virtual std::unique_ptr<AbstractRanker> Clone() const = 0;
+
     /*
     Provides a name for the ranker.
 
@@ -90,6 +150,35 @@ public:
     */
     virtual std::string GetDebugInfo() const;
 
+    /*
+    Provides whether the guesses made with the ranker can be reused.
+
+    A ranker is deterministic if, for a given dictionary, its ranks only depend
+    on what was passed to SetUp and the words ranked, and its name (GetName)
+    identifies all of its parameters. The guesses made with a deterministic
+    ranker can then be saved and reused later without calling SetUp or ranking
+    (see OpeningBook). A default implementation is provided that returns true.
+
+    Returns:
+        Whether the ranker is deterministic.
+    */
+    virtual bool IsDeterministic() const;
+
+    /*
+    Provides a checksum of the data files the ranker reads.
+
+    The name of a ranker identifies its parameters, but not the contents of the
+    files it was given (e.g. the frequency file of WordFrequencyRanker). So,
+    guesses saved across runs (see OpeningBook) are stored under the name and
+    this checksum, and are not reused once such a file changes. Rankers built
+    on another AbstractRanker include its checksum. A default implementation is
+    provided that returns 0 (no data files).
+
+    Returns:
+        Checksum of the ranker's data files.
+    */
+    virtual uint64_t GetDataChecksum() const;
+
 protected:
     /*
     Sets the name of the ranker. 
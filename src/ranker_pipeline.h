@@ -0,0 +1,432 @@
+/*
+Header for ranker pipelines.
+
+This file declares the Pipeline class template which composes a ranker with
+penalty stages at compile time, the stages that match ProgressDuplicateRanker,
+ProgressVowelRanker, and ProgressWordFrequencyRanker, and PipelineRanker
+which adapts a Pipeline to an AbstractRanker.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef RANKER_PIPELINE_H
+#define RANKER_PIPELINE_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "ranker.h"
+#include "duplicate_ranker.h"
+#include "vowel_ranker.h"
+#include "word_frequency_ranker.h"
+
+/*
+Counts the letters that have been found according to some feedback.
+
+Parameters:
+    feedback: Feedback on the previous guess (see WordleSolver::Guess(std::string_view)).
+
+Returns:
+    The number of green and yellow letters (0 for the placeholder feedback of
+    the first guess).
+*/
+inline unsigned short CountFound(std::string_view feedback)
+{
+    return static_cast<unsigned short>(feedback.size() - std::count(feedback.cbegin(), feedback.cend(), 'b'));
+}
+
+/*
+Stage that penalizes duplicate letters like ProgressDuplicateRanker.
+
+A stage adds a penalty to the rank of the ranker it is composed with in a
+Pipeline. Every stage provides:
+    void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
+    bool IsActive() const (whether Penalty is added after the latest SetUp)
+    int Penalty(const Word &word) const
+    std::string GetName(const std::string &inner_name) const (name of the
+    equivalent AbstractRanker built on a ranker named inner_name)
+    uint64_t GetDataChecksum() const (checksum of the data files the stage
+    reads, see AbstractRanker::GetDataChecksum)
+
+Template:
+    DuplicatePenalty: Penalty applied for each duplicate letter.
+    NumFound: Number of letters that need to be found for duplicates to no
+              longer be penalized.
+*/
+template <int DuplicatePenalty, unsigned short NumFound = 6>
+class ProgressDuplicateStage
+{
+public:
+    void SetUp(const EligibleWords & /*eligible*/, unsigned short /*guess*/, std::string_view feedback)
+    {
+        curr_found = CountFound(feedback);
+    }
+
+    bool IsActive() const
+    {
+        return curr_found < NumFound;
+    }
+
+    int Penalty(const Word &word) const
+    {
+        return DuplicatePenalty * CountDuplicates(word.mask);
+    }
+
+    std::string GetName(const std::string &inner_name) const
+    {
+        return "ProgressDuplicateRanker(" + inner_name + "," + std::to_string(DuplicatePenalty) + "," + std::to_string(NumFound) + ")";
+    }
+
+    uint64_t GetDataChecksum() const
+    {
+        return 0;
+    }
+
+private:
+    unsigned short curr_found{0};
+};
+
+/*
+Stage that penalizes consonants like ProgressVowelRanker (see ProgressDuplicateStage).
+
+Template:
+    ConsonantPenalty: Penalty applied for each consonant.
+    NumFound: Number of letters that need to be found for consonants to no
+              longer be penalized.
+*/
+template <int ConsonantPenalty, unsigned short NumFound = 7>
+class ProgressVowelStage
+{
+public:
+    void SetUp(const EligibleWords & /*eligible*/, unsigned short /*guess*/, std::string_view feedback)
+    {
+        curr_found = CountFound(feedback);
+    }
+
+    bool IsActive() const
+    {
+        return curr_found < NumFound;
+    }
+
+    int Penalty(const Word &word) const
+    {
+        return ConsonantPenalty * CountConsonants(word.code);
+    }
+
+    std::string GetName(const std::string &inner_name) const
+    {
+        return "ProgressVowelRanker(" + inner_name + "," + std::to_string(ConsonantPenalty) + "," + std::to_string(NumFound) + ")";
+    }
+
+    uint64_t GetDataChecksum() const
+    {
+        return 0;
+    }
+
+private:
+    unsigned short curr_found{0};
+};
+
+/*
+Stage that adds the popularity rank like ProgressWordFrequencyRanker (see
+ProgressDuplicateStage).
+
+Template:
+    NumFound: Number of letters that need to be found for the popularity rank
+              to be added.
+*/
+template <unsigned short NumFound = 6>
+class ProgressWordFrequencyStage
+{
+public:
+    /*
+    Constructs a ProgressWordFrequencyStage.
+
+    Parameters:
+        freq_fp: Filepath to a frequency CSV file (see WordFrequencyRanker()).
+    */
+    ProgressWordFrequencyStage(const std::string &freq_fp) : ranking(PopularityRanking::Load(freq_fp)) {}
+
+    // Resolves the popularity ranks of the Dictionary's words like WordFrequencyRanker::SetUp
+    void SetUp(const EligibleWords &eligible, unsigned short /*guess*/, std::string_view feedback)
+    {
+        auto d{eligible.GetDictionary()};
+        if (d != nullptr && (ranks_by_id == nullptr || ranks_checksum != d->GetChecksum()))
+        {
+            ranks_by_id = ranking->GetRanksById(*d);
+            ranks_checksum = d->GetChecksum();
+        }
+        curr_found = CountFound(feedback);
+    }
+
+    bool IsActive() const
+    {
+        return curr_found >= NumFound;
+    }
+
+    int Penalty(const Word &word) const
+    {
+        return (ranks_by_id != nullptr && word.id != Word::NO_ID) ? (*ranks_by_id)[word.id] : ranking->Find(word.text);
+    }
+
+    std::string GetName(const std::string &inner_name) const
+    {
+        return "ProgressWordFrequencyRanker(" + inner_name + ",\"" + ranking->GetFilePath() + "\"," + std::to_string(NumFound) + ")";
+    }
+
+    uint64_t GetDataChecksum() const
+    {
+        return ranking->GetChecksum();
+    }
+
+private:
+    // Popularity ranking, shared (not copied) by copies of the stage
+    std::shared_ptr<const PopularityRanking> ranking;
+
+    // Popularity ranks by id of the Dictionary with checksum ranks_checksum
+    std::shared_ptr<const std::vector<int>> ranks_by_id;
+    uint64_t ranks_checksum{0};
+
+    unsigned short curr_found{0};
+};
+
+/*
+A ranker composed with penalty stages at compile time.
+
+Pipeline<S1, ..., Sn, R> ranks like the chain of decorator rankers
+S1(...Sn(R)...) where each stage Si is the stage version of a decorator
+(e.g. ProgressDuplicateStage for ProgressDuplicateRanker) and R is a concrete
+AbstractRanker. The stages and R are held by value and called without virtual
+dispatch, so RankAll is R's RankAllExact followed by one loop adding the
+penalties of the active stages, and SetUp and Rank inline into one function
+each.
+
+Implementation in header because it is a template, see CountsToRanks in misc.h.
+
+Template:
+    Parts: The stages (outermost first) followed by the ranker.
+*/
+template <typename... Parts>
+class Pipeline
+{
+public:
+    static_assert(sizeof...(Parts) >= 1, "A pipeline needs a ranker");
+
+    // Number of stages
+    static constexpr size_t NUM_STAGES{sizeof...(Parts) - 1};
+
+    // Type of the ranker the stages are composed with
+    using Base = std::tuple_element_t<NUM_STAGES, std::tuple<Parts...>>;
+
+    /*
+    Constructs a Pipeline.
+
+    Parameters:
+        parts: The stages (outermost first) followed by the ranker.
+    */
+    Pipeline(Parts... parts) : parts(std::move(parts)...) {}
+
+    // Sets up the ranker and the stages (see AbstractRanker::SetUp).
+    void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
+    {
+        GetBase().Base::SetUp(eligible, guess, feedback);
+        ForEachStage([&eligible, guess, feedback](auto &stage)
+                     { stage.SetUp(eligible, guess, feedback); });
+    }
+
+    // Ranks a word (see AbstractRanker::Rank).
+    int Rank(std::string_view word) const
+    {
+        Word w{word, Word::NO_ID, EncodeWord(word), LetterMask(word)};
+        return GetBase().Base::Rank(word) + Penalty(w, std::make_index_sequence<NUM_STAGES>{});
+    }
+
+    // Ranks a batch of words (see AbstractRanker::RankAll). The penalties are
+    // added to the ranker's exact ranks (see AbstractRanker::RankAllExact).
+    void RankAll(std::span<const Word> words, std::span<int> ranks) const
+    {
+        if constexpr (NUM_STAGES == 0)
+        {
+            GetBase().Base::RankAll(words, ranks);
+        }
+        else
+        {
+            RankAllExact(words, ranks);
+        }
+    }
+
+    // Ranks a batch of words exactly (see AbstractRanker::RankAllExact).
+    void RankAllExact(std::span<const Word> words, std::span<int> ranks) const
+    {
+        GetBase().Base::RankAllExact(words, ranks);
+        for (size_t i{0}; i < words.size(); i++)
+        {
+            ranks[i] += Penalty(words[i], std::make_index_sequence<NUM_STAGES>{});
+        }
+    }
+
+    // Name of the equivalent chain of decorator rankers.
+    std::string GetName() const
+    {
+        return WrapName(GetBase().GetName(), std::make_index_sequence<NUM_STAGES>{});
+    }
+
+    // Returns GetDebugInfo() of the ranker.
+    std::string GetDebugInfo() const
+    {
+        return GetBase().Base::GetDebugInfo();
+    }
+
+    // Returns IsDeterministic() of the ranker.
+    bool IsDeterministic() const
+    {
+        return GetBase().Base::IsDeterministic();
+    }
+
+    // Checksum of the equivalent chain of decorator rankers (see AbstractRanker::GetDataChecksum).
+    uint64_t GetDataChecksum() const
+    {
+        return WrapDataChecksum(GetBase().Base::GetDataChecksum(), std::make_index_sequence<NUM_STAGES>{});
+    }
+
+private:
+    // The stages followed by the ranker
+    std::tuple<Parts...> parts;
+
+    const Base &GetBase() const
+    {
+        return std::get<NUM_STAGES>(parts);
+    }
+
+    Base &GetBase()
+    {
+        return std::get<NUM_STAGES>(parts);
+    }
+
+    // Calls f on every stage
+    template <typename Functor>
+    void ForEachStage(const Functor &f)
+    {
+        [this, &f]<size_t... I>(std::index_sequence<I...>)
+        { (f(std::get<I>(parts)), ...); }(std::make_index_sequence<NUM_STAGES>{});
+    }
+
+    // Sum of the penalties of the active stages
+    template <size_t... I>
+    int Penalty(const Word &word, std::index_sequence<I...>) const
+    {
+        return (0 + ... + (std::get<I>(parts).IsActive() ? std::get<I>(parts).Penalty(word) : 0));
+    }
+
+    // Wraps the name of the ranker in the names of the stages, innermost first
+    template <size_t... I>
+    std::string WrapName(std::string name, std::index_sequence<I...>) const
+    {
+        ((name = std::get<NUM_STAGES - 1 - I>(parts).GetName(name)), ...);
+        return name;
+    }
+
+    // Combines the data checksum of the ranker with those of the stages,
+    // innermost first, like the equivalent decorator rankers do
+    template <size_t... I>
+    uint64_t WrapDataChecksum(uint64_t checksum, std::index_sequence<I...>) const
+    {
+        ((checksum = CombineDataChecksums(checksum, std::get<NUM_STAGES - 1 - I>(parts).GetDataChecksum())), ...);
+        return checksum;
+    }
+
+    // Combines the checksum of the inner ranker with that of a stage, stages
+    // without data files (checksum 0) pass it through (see WordFrequencyRanker::GetDataChecksum)
+    static uint64_t CombineDataChecksums(uint64_t inner, uint64_t stage)
+    {
+        return (stage == 0) ? inner : (inner ^ stage) * 1099511628211ull;
+    }
+};
+
+/*
+Adapts a Pipeline to an AbstractRanker so it can be used by WordleSolver and
+the evaluation header.
+
+Each AbstractRanker call is one virtual call into the Pipeline. The default
+name is the name of the equivalent chain of decorator rankers since it ranks
+the same (so the two share openings and cached guesses).
+
+Implementation in header because it is a template, see CountsToRanks in misc.h.
+
+Template:
+    P: A Pipeline type.
+*/
+template <typename P>
+class PipelineRanker : public AbstractRanker
+{
+public:
+    /*
+    Constructs a PipelineRanker.
+
+    Parameters:
+        p: Pipeline to rank with (copied).
+    */
+    PipelineRanker(const P &p) : PipelineRanker(p.GetName(), p) {}
+
+    /*
+    Overloaded version of PipelineRanker(const P&) that allows name specification.
+
+    Parameters:
+        name: Name for the ranker
+        p: Pipeline to rank with (copied).
+    */
+    PipelineRanker(std::string_view name, const P &p) : AbstractRanker(name), pipeline(p) {}
+
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override
+    {
+        pipeline.SetUp(eligible, guess, feedback);
+    }
+
+    virtual int Rank(std::string_view word) const override
+    {
+        return pipeline.Rank(word);
+    }
+
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override
+    {
+        pipeline.RankAll(words, ranks);
+    }
+
+    virtual void RankAllExact(std::span<const Word> words, std::span<int> ranks) const override
+    {
+        pipeline.RankAllExact(words, ranks);
+    }
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override
+    {
+        return std::make_unique<PipelineRanker>(*this);
+    }
+
+    virtual bool IsDeterministic() const override
+    {
+        return pipeline.IsDeterministic();
+    }
+
+    virtual uint64_t GetDataChecksum() const override
+    {
+        return pipeline.GetDataChecksum();
+    }
+
+    virtual std::string GetDebugInfo() const override
+    {
+        return pipeline.GetDebugInfo();
+    }
+
+private:
+    P pipeline;
+};
+
+#endif
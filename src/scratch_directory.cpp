@@ -0,0 +1,74 @@
+// Implementation of ScratchDirectory
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "scratch_directory.h"
+#include "misc.h"
+#include <filesystem>
+#include <random>
+#include <mutex>
+#include <sstream>
+
+const std::string ScratchDirectory::NAME_PREFIX = "wordle-solver-";
+
+ScratchDirectory::ScratchDirectory() : ScratchDirectory(GetDefaultParent()) {}
+
+ScratchDirectory::ScratchDirectory(std::string_view parent)
+{
+    // Random names are shared by all threads, random_device also differs
+    // between processes so names from separate processes do not collide
+    static std::mutex name_mutex;
+    static std::mt19937_64 name_engine{std::random_device{}()};
+
+    // create_directory only succeeds if the directory did not exist, so the
+    // first name that succeeds belongs to this object alone
+    const unsigned short MAX_ATTEMPTS{100};
+    for (unsigned short attempt{0}; attempt < MAX_ATTEMPTS; attempt++)
+    {
+        std::ostringstream name;
+        {
+            std::lock_guard<std::mutex> lock(name_mutex);
+            name << NAME_PREFIX << std::hex << name_engine();
+        }
+
+        auto candidate{std::filesystem::path(parent) / name.str()};
+        std::error_code error;
+        if (std::filesystem::create_directory(candidate, error))
+        {
+            path = candidate.string();
+            return;
+        }
+        if (error)
+        {
+            throw WordleSolverException("Could not create scratch directory in " + std::string(parent) + ": " + error.message());
+        }
+    }
+    throw WordleSolverException("Could not find an unused scratch directory name in " + std::string(parent));
+}
+
+ScratchDirectory::~ScratchDirectory()
+{
+    // Destructors must not throw, a directory that cannot be removed is left behind
+    std::error_code error;
+    std::filesystem::remove_all(path, error);
+}
+
+std::string ScratchDirectory::GetFilePath(std::string_view name) const
+{
+    return (std::filesystem::path(path) / name).string();
+}
+
+const std::string &ScratchDirectory::GetPath() const
+{
+    return path;
+}
+
+std::string ScratchDirectory::GetDefaultParent()
+{
+    std::error_code error;
+    if (std::filesystem::is_directory("/dev/shm", error))
+    {
+        return "/dev/shm";
+    }
+    return std::filesystem::temp_directory_path().string();
+}
@@ -0,0 +1,81 @@
+/*
+Header for ScratchDirectory.
+
+This file declares the ScratchDirectory class which owns a uniquely named
+directory for temporary files that is deleted when it is no longer needed.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef SCRATCH_DIRECTORY_H
+#define SCRATCH_DIRECTORY_H
+
+#include <string>
+#include <string_view>
+
+/*
+A uniquely named directory for temporary files.
+
+The directory is created by the constructor and removed along with everything
+in it by the destructor. Each object gets its own directory, so objects in
+different threads or processes never share files. Copying is disabled as the
+object owns the directory.
+*/
+class ScratchDirectory
+{
+public:
+    /*
+    Creates a scratch directory in the default location.
+
+    The default location is /dev/shm when it exists (so the files are kept in
+    memory-backed tmpfs), otherwise the system temporary directory.
+
+    Throws:
+        WordleSolverException if the directory cannot be created.
+    */
+    ScratchDirectory();
+
+    /*
+    Creates a scratch directory inside a given directory.
+
+    Parameters:
+        parent: Existing directory to create the scratch directory in.
+
+    Throws:
+        WordleSolverException if the directory cannot be created.
+    */
+    ScratchDirectory(std::string_view parent);
+
+    // Removes the directory and everything in it.
+    ~ScratchDirectory();
+
+    ScratchDirectory(const ScratchDirectory &) = delete;
+    ScratchDirectory &operator=(const ScratchDirectory &) = delete;
+
+    /*
+    Gets the path to a file in the directory.
+
+    Parameters:
+        name: Name of the file.
+
+    Returns:
+        The path to the file (the file is not created).
+    */
+    std::string GetFilePath(std::string_view name) const;
+
+    // Path to the directory.
+    const std::string &GetPath() const;
+
+    // Default location scratch directories are created in (see ScratchDirectory()).
+    static std::string GetDefaultParent();
+
+private:
+    // Path to the directory
+    std::string path;
+
+    // Prefix of the names of scratch directories
+    static const std::string NAME_PREFIX;
+};
+
+#endif
@@ -5,8 +5,14 @@
 #include "solver.h"
 #include <fstream>
 #include <limits>
+#include <climits>
+#include <algorithm>
+#include <numeric>
 #include <iostream>
+#include <functional>
 #include "misc.h"
+#include "constraint.h"
+#include "feedback.h"
 #include <iomanip>
 #include <ctime>
 #include <sstream>
@@ -21,15 +27,42 @@ public:
     template <typename Functor>
     static void KeepOnPredicate(WordleSolver &self, const Functor &predicate)
     {
+        if (self.eligible.IsInMemory())
+        {
+            // Compact the eligible arrays in place, kept words stay in dictionary order
+            auto &eligible{self.eligible};
+            size_t kept{0};
+            for (size_t i{0}; i < eligible.ids.size(); i++)
+            {
+                auto word{(*self.dictionary)[eligible.ids[i]]};
+                if (!predicate(word))
+                {
+                    if (self.debug_mode)
+                    {
+                        Private::DebugLog(self, "Removed word [" + std::string(word) + "]");
+                    }
+
+                    continue;
+                }
+
+                eligible.ids[kept] = eligible.ids[i];
+                eligible.codes[kept] = eligible.codes[i];
+                eligible.masks[kept] = eligible.masks[i];
+                kept++;
+            }
+            Private::ResizeEligible(self, kept);
+            return;
+        }
+
         // Read-only file stream to eligible words file
-        std::ifstream eligible_file_r(self.eligible_fp, std::ios_base::in);
+        std::ifstream eligible_file_r(self.eligible.eligible_fp, std::ios_base::in);
         if (!eligible_file_r.is_open())
         {
-            throw WordleSolverException("Could not open " + self.eligible_fp + " for reading");
+            throw WordleSolverException("Could not open " + self.eligible.eligible_fp + " for reading");
         }
 
         // Construct path to temporary file used to reduce eligible words
-        std::string temp_fp{InsertFilePathSuffix(self.eligible_fp, ELIGIBLE_FP_SUFFIX)};
+        std::string temp_fp{InsertFilePathSuffix(self.eligible.eligible_fp, ELIGIBLE_FP_SUFFIX)};
 
         // Open read and write file stream to this file, trunc specifies that this file will be created
         // if it does not exist already
@@ -77,10 +110,10 @@ public:
         eligible_file_r.close();
 
         // Write-only file stream to eligible words file (will overwrite it)
-        std::ofstream eligible_file_w(self.eligible_fp, std::ios_base::out);
+        std::ofstream eligible_file_w(self.eligible.eligible_fp, std::ios_base::out);
         if (!eligible_file_w.is_open())
         {
-            throw WordleSolverException("Could not open " + self.eligible_fp + " for writing");
+            throw WordleSolverException("Could not open " + self.eligible.eligible_fp + " for writing");
         }
 
         // Resets temp file stream to beginning as we now we will be
@@ -110,127 +143,370 @@ public:
 
         temp_file_rw.close();
         eligible_file_w.close();
+        self.eligible.InvalidateStatistics();
     }
 
-    // Updates the eligible words stored by a WordleSolver given feedback
+    // Updates the eligible words stored by a WordleSolver given feedback along
+    // with their statistics
     static void UpdateEligibleWords(WordleSolver &self, std::string_view feedback)
     {
-        // Set of characters that have been identified as yellow
-        std::unordered_set<char> yellow;
-
-        // First we will pass over feedback and just work with green feedback in the hope
-        // that learning prev_guess[idx] for is meant to be at index idx will clear out
-        // a lot of eligible words
-        for (auto fitr{feedback.cbegin()}; fitr != feedback.cend(); fitr++)
+        // When the statistics of the words are known, keep the words from before
+        // filtering so the statistics can be updated with just the removed words
+        auto &eligible{self.eligible};
+        if (eligible.IsInMemory() && eligible.statistics)
         {
-            auto idx{std::distance(feedback.cbegin(), fitr)};
-            // Feedback green at this letter => found correct letter in correct place, if
-            // this found only on the previous guess we need to adjust eligible words.
-            if (*fitr == 'g' && self.found_indices.find(idx) == self.found_indices.end())
+            self.prev_ids = eligible.ids;
+            self.prev_codes = eligible.codes;
+            self.prev_masks = eligible.masks;
+            Private::FilterEligibleWords(self, feedback);
+            Private::UpdateFingerprint(self);
+            if (!Private::FindStatistics(self))
             {
-                if (self.debug_mode)
-                {
-                    Private::DebugLog(self, "Running Green Predicate for idx [" + std::to_string(idx) + "]");
-                }
+                eligible.UpdateStatistics(self.prev_ids, self.prev_codes, self.prev_masks);
+            }
+            return;
+        }
 
-                // Green predicate: Keep only words of eligible words that have prev_guess[idx]
-                // at idx
-                Private::KeepOnPredicate(self, [&self, &idx](std::string_view word)
-                                         { return word[idx] == self.prev_guess[idx]; });
+        Private::FilterEligibleWords(self, feedback);
+        Private::UpdateFingerprint(self);
+        eligible.InvalidateStatistics();
+        Private::FindStatistics(self);
+    }
 
-                // Mark that we have found letter at idx, this means in future guesses that
-                // are made by the solver, we won't go through eligible words uneccessarily
-                // as we have ensured above that all the eligible words in future rounds
-                // will only have prev_guess[idx] at idx
-                self.found_indices.insert(idx);
-            }
+    // Fingerprints the eligible words if a cache is used
+    static void UpdateFingerprint(WordleSolver &self)
+    {
+        if (self.statistics_cache || self.guess_cache)
+        {
+            self.eligible_fingerprint = self.eligible.GetFingerprint();
+        }
+    }
+
+    // Uses the cached statistics of the eligible words if there are any, returns
+    // whether it did
+    static bool FindStatistics(WordleSolver &self)
+    {
+        if (!self.statistics_cache)
+        {
+            return false;
+        }
+        auto statistics{self.statistics_cache->Find(self.eligible_fingerprint)};
+        if (!statistics)
+        {
+            return false;
+        }
+        self.eligible.statistics = statistics;
+        return true;
+    }
+
+    // Key of the guess made with the eligible words after feedback in the guess cache
+    static uint64_t GuessKey(const WordleSolver &self, std::string_view feedback)
+    {
+        uint64_t feedback_code{(feedback == FEEDBACK_PLACEHOLDER) ? NUM_FEEDBACK_CODES : static_cast<uint64_t>(EncodeFeedback(feedback))};
+        uint64_t setup{((self.num_guesses + 1ull) << 16) | (feedback_code << 1) | self.hard_mode};
+        auto key{MixFingerprint(self.eligible_fingerprint ^ std::hash<std::string>{}(self.ranker->GetName()))};
+        return MixFingerprint(key ^ setup);
+    }
+
+    // Makes the guess from the guess cache if it can be (see SetGuessCache),
+    // returns whether it did
+    static bool GuessFromCache(WordleSolver &self, std::string_view feedback, std::string &guess)
+    {
+        if (!self.guess_cache || self.debug_mode || !self.ranker->IsDeterministic())
+        {
+            return false;
+        }
+        auto cached_guess{self.guess_cache->Find(GuessKey(self, feedback))};
+        if (!cached_guess)
+        {
+            return false;
+        }
+
+        guess = *cached_guess;
+        self.num_guesses++;
+        self.in_opening = false;
+        self.prev_guess = guess;
+        self.dictionary->Find(guess, self.prev_guess_id);
+        return true;
+    }
+
+    // Adds the statistics the ranker computed and the guess to the caches in use
+    static void CacheResults(WordleSolver &self, std::string_view feedback, const std::string &guess)
+    {
+        if (self.statistics_cache && self.eligible.statistics)
+        {
+            self.statistics_cache->Insert(self.eligible_fingerprint, self.eligible.statistics);
+        }
+        if (self.guess_cache && !self.debug_mode && self.ranker->IsDeterministic())
+        {
+            self.guess_cache->Insert(GuessKey(self, feedback), std::make_shared<const std::string>(guess));
+        }
+    }
+
+    // Removes the eligible words that do not match feedback on the previous guess
+    static void FilterEligibleWords(WordleSolver &self, std::string_view feedback)
+    {
+        if (self.feedback_matrix && !self.debug_mode)
+        {
+            Private::FilterByMatrix(self, feedback);
+            return;
+        }
+
+        // All of the feedback (green, yellow, and black letters) is compiled into one
+        // constraint so that the eligible words are only scanned once
+        FeedbackConstraint constraint(self.prev_guess, feedback);
+
+        if (self.debug_mode)
+        {
+            Private::DebugLog(self, "Running Feedback Constraint for guess [" + self.prev_guess + "]");
         }
 
-        // Next pass over feedback will deal with yellow and black feedback as those will
-        // most likely remove less words
-        for (auto fitr{feedback.cbegin()}; fitr != feedback.cend(); fitr++)
+        // In memory, the packed words are filtered by the vectorized kernel. Otherwise
+        // (or to log each removed word) fall back to checking the words one at a time
+        if (self.eligible.IsInMemory() && !self.debug_mode)
         {
-            auto idx{std::distance(feedback.cbegin(), fitr)};
-            if (*fitr == 'y')
+            auto &eligible{self.eligible};
+            Private::ResizeEligible(self, constraint.Filter(eligible.ids.data(), eligible.codes.data(), eligible.masks.data(), eligible.ids.size()));
+            return;
+        }
+
+        Private::KeepOnPredicate(self, [&constraint](std::string_view word)
+                                 { return constraint.Matches(word); });
+    }
+
+    // Keeps the eligible words whose feedback against the previous guess (looked
+    // up in the feedback matrix) is the received feedback
+    static void FilterByMatrix(WordleSolver &self, std::string_view feedback)
+    {
+        auto &eligible{self.eligible};
+        auto row{self.feedback_matrix->Row(self.prev_guess_id)};
+        auto code{EncodeFeedback(feedback)};
+        size_t kept{0};
+        for (size_t i{0}; i < eligible.ids.size(); i++)
+        {
+            if (row[eligible.ids[i]] == code)
             {
-                if (self.debug_mode)
-                {
-                    Private::DebugLog(self, "Running Yellow Predicate for idx [" + std::to_string(idx) + "]");
-                }
+                eligible.ids[kept] = eligible.ids[i];
+                eligible.codes[kept] = eligible.codes[i];
+                eligible.masks[kept] = eligible.masks[i];
+                kept++;
+            }
+        }
+        Private::ResizeEligible(self, kept);
+    }
 
-                // Mark letter has been found as yellow (used in black predicate)
-                yellow.insert(self.prev_guess[idx]);
+    // Appends to the solver's words the dictionary words that are not eligible but
+    // can split the eligible words (see SetHardMode). This only filters out
+    // probe words that give no information at all (the same feedback for every
+    // eligible word), it does not bound their scores, so every other probe word
+    // is still ranked
+    static void AddProbeWords(WordleSolver &self)
+    {
+        const auto &dictionary{*self.dictionary};
+        const auto &eligible{self.eligible};
+        if (eligible.ids.size() == dictionary.Size())
+        {
+            return;
+        }
 
-                // Yellow predicate: keep words where prev_guess[idx] occurs somewhere in
-                // the word other than idx or any of the indices that have been found
-                Private::KeepOnPredicate(self, [&self, &idx](std::string_view word)
-                                         {
-                    auto loc{word.find(self.prev_guess[idx])};
+        self.is_eligible.assign(dictionary.Size(), false);
+        for (auto id : eligible.ids)
+        {
+            self.is_eligible[id] = true;
+        }
 
-                    // If loc == npos we have searched all instances of prev_guess[idx]
-                    // and none of them matched desired conditions
-                    while (loc != std::string::npos) {
+        // A guess letter c at position i gets the same color for every eligible
+        // word if the eligible words all have (or all lack) c at i and all have
+        // (or all lack) c. A repeated guess letter can also get yellow or black
+        // depending on how many times c appears, so it is informative if any
+        // eligible word has c
+        const auto &statistics{eligible.GetStatistics()};
+        auto n{statistics.GetNumWords()};
+        const auto &letter_counts{statistics.GetLetterCounts()};
+        uint32_t present_mask{0};
+        bool informative[WORD_LENGTH][NUM_LETTERS];
+        for (unsigned short c{0}; c < NUM_LETTERS; c++)
+        {
+            auto letter_varies{letter_counts[c] > 0 && letter_counts[c] < n};
+            if (letter_counts[c] > 0)
+            {
+                present_mask |= 1u << c;
+            }
+            for (unsigned short i{0}; i < WORD_LENGTH; i++)
+            {
+                auto position_count{statistics.GetPositionCounts(i)[c]};
+                informative[i][c] = letter_varies || (position_count > 0 && position_count < n);
+            }
+        }
 
-                        // Keep the word if we have found an instance of prev_guess[idx]
-                        // that is not at index and has not been found already
-                        if (loc != idx && self.found_indices.find(loc) == self.found_indices.end()) {
-                            return true;
-                        }
+        auto codes{dictionary.GetCodes()};
+        auto masks{dictionary.GetMasks()};
+        for (uint32_t id{0}; id < dictionary.Size(); id++)
+        {
+            if (self.is_eligible[id])
+            {
+                continue;
+            }
 
-                        // Search for next occurrence of self.prev_guess[idx] starting
-                        // from character after
-                        loc = word.find(self.prev_guess[idx], loc + 1);
-                    }
+            auto code{codes[id]};
+            uint32_t seen{0};
+            uint32_t repeated{0};
+            auto useful{false};
+            for (unsigned short i{0}; i < WORD_LENGTH; i++)
+            {
+                auto c{CodeLetter(code, i)};
+                useful = useful || informative[i][c];
+                repeated |= seen & (1u << c);
+                seen |= 1u << c;
+            }
+            if (useful || (repeated & present_mask) != 0)
+            {
+                self.words.push_back(Word{dictionary[id], id, code, masks[id]});
+            }
+        }
+    }
 
-                    return false; });
+    // Makes the guess from the opening book if it can be (see SetOpeningBook),
+    // returns whether it did
+    static bool GuessFromBook(WordleSolver &self, std::string_view feedback, std::string &guess)
+    {
+        if (!self.opening_book || self.debug_mode || !self.ranker->IsDeterministic())
+        {
+            return false;
+        }
+
+        if (feedback == FEEDBACK_PLACEHOLDER)
+        {
+            if (!self.opening_book->Find(*self.dictionary, *self.ranker, self.hard_mode, self.opening))
+            {
+                Private::BuildOpening(self);
             }
-            else if (*fitr == 'b')
+            Private::CopyDictionary(self);
+            self.num_guesses = 0;
+            guess = self.opening.first;
+        }
+        else
+        {
+            if (!self.in_opening || self.num_guesses != 1)
             {
-                if (self.debug_mode)
+                return false;
+            }
+            if (self.opening.second[EncodeFeedback(feedback)].empty())
+            {
+                if (!self.lazy_opening)
                 {
-                    Private::DebugLog(self, "Running Black Predicate for idx [" + std::to_string(idx) + "]");
+                    return false;
                 }
+                Private::AddSecondGuess(self, feedback, guess);
+                return true;
+            }
+            Private::UpdateEligibleWords(self, feedback);
+            guess = self.opening.second[EncodeFeedback(feedback)];
+        }
 
-                Private::KeepOnPredicate(self, [&self, &idx, &yellow](std::string_view word)
-                                         {
-                // Black predicate: If prev_guess[idx] was seen at an earlier index and was 
-                // marked yellow, then only keep words where it has a character other than
-                // prev_guess[idx] at idx. Why? If we have feedback where a letter is first
-                // marked yellow at index i than later black at index j, that means the letter 
-                // occurs in the word at neither i or j, but could be anywhere else. Example:
-                // Feedback for guess "three" for solution "beach" is "bybyb".
-                if (yellow.find(self.prev_guess[idx]) != yellow.end())
-                {
-                    return word[idx] != self.prev_guess[idx];
-                }
-                // If prev_guess[idx] was not seen at an earlier index and marked yellow, then
-                // only keep words where prev_guess[idx] is not anywhere in the word other than
-                // the found indices. Why? A letter can be marked black at some letter(s) and
-                // green at others. Example: Feedback for guess "there" for solution "their"
-                // is "gggyb".
-                auto loc{word.find(self.prev_guess[idx])};
-
-                // Reached end of word without finding prev_guess[idx] that is not at a found
-                // index - keep the word
-                while (loc != std::string::npos) {
-
-                    // Found prev_guess[idx] somewhere other than correct indices in word
-                    // means we should reject the word
-                    if (self.found_indices.find(loc) == self.found_indices.end()) {
-                        return false;
-                    }
+        self.num_guesses++;
+        self.prev_guess = guess;
+        self.dictionary->Find(guess, self.prev_guess_id);
+        self.in_opening = true;
+        return true;
+    }
 
-                    loc = word.find(self.prev_guess[idx], loc+1);
+    // Ranks the opening for the solver's dictionary, ranker, and mode and adds it
+    // to the opening book (only the first guess if the book is filled lazily)
+    static void BuildOpening(WordleSolver &self)
+    {
+        // The book is detached so the guesses below are ranked
+        auto book{std::move(self.opening_book)};
+        OpeningBook::Opening opening;
+        try
+        {
+            opening.first = self.Guess();
+            if (self.lazy_opening)
+            {
+                self.opening_book = book;
+                self.opening_book->Insert(*self.dictionary, *self.ranker, self.hard_mode, opening);
+                self.opening = opening;
+                return;
+            }
+            auto first_id{self.prev_guess_id};
+            auto first_code{EncodeWord(opening.first)};
+            auto after_first{self.eligible};
+
+            // Only feedback that some eligible word gives can be received
+            bool possible[NUM_FEEDBACK_CODES]{};
+            for (auto code : after_first.codes)
+            {
+                possible[GetFeedbackCode(first_code, code)] = true;
+            }
+
+            // Every second guess starts from the state after the first guess
+            for (size_t c{0}; c < NUM_FEEDBACK_CODES; c++)
+            {
+                if (possible[c])
+                {
+                    self.eligible = after_first;
+                    self.num_guesses = 1;
+                    self.prev_guess = opening.first;
+                    self.prev_guess_id = first_id;
+                    opening.second[c] = self.Guess(DecodeFeedback(static_cast<uint8_t>(c)));
                 }
-                
-                return true; });
             }
         }
+        catch (...)
+        {
+            self.opening_book = book;
+            throw;
+        }
+
+        self.opening_book = book;
+        self.opening_book->Insert(*self.dictionary, *self.ranker, self.hard_mode, opening);
+        self.opening = opening;
     }
 
-    // Copies dictionary into eligible words file
+    // Ranks the second guess after feedback on the first guess of a lazily
+    // filled opening and adds it to the opening book
+    static void AddSecondGuess(WordleSolver &self, std::string_view feedback, std::string &guess)
+    {
+        // The book is detached so the guess is ranked
+        auto book{std::move(self.opening_book)};
+        try
+        {
+            guess = self.Guess(feedback);
+        }
+        catch (...)
+        {
+            self.opening_book = book;
+            throw;
+        }
+        self.opening_book = book;
+
+        // Another solver sharing the book may have added other second guesses
+        OpeningBook::Opening stored;
+        if (self.opening_book->Find(*self.dictionary, *self.ranker, self.hard_mode, stored) && stored.first == self.opening.first)
+        {
+            self.opening = stored;
+        }
+        self.opening.second[EncodeFeedback(feedback)] = guess;
+        self.opening_book->Insert(*self.dictionary, *self.ranker, self.hard_mode, self.opening);
+    }
+
+    // Shrinks the in-memory eligible words to the first n after compaction
+    static void ResizeEligible(WordleSolver &self, size_t n)
+    {
+        self.eligible.ids.resize(n);
+        self.eligible.codes.resize(n);
+        self.eligible.masks.resize(n);
+    }
+
+    // Copies dictionary into eligible words (all ids in memory or file copy)
     static void CopyDictionary(WordleSolver &self)
     {
+        if (self.eligible.IsInMemory())
+        {
+            self.eligible = EligibleWords(self.dictionary.get());
+            return;
+        }
+
         // Read-only file stream for dictionary
         std::ifstream dictionary_file(self.dictionary_fp, std::ios_base::in);
         if (!dictionary_file.is_open())
@@ -239,7 +515,7 @@ public:
         }
 
         // Write-only file stream for eligible words
-        std::ofstream eligible_file(self.eligible_fp, std::ios_base::out);
+        std::ofstream eligible_file(self.eligible.eligible_fp, std::ios_base::out);
         if (!eligible_file.is_open())
         {
             throw WordleSolverException("Could not open eligible words file for writing");
@@ -266,6 +542,22 @@ public:
 
         dictionary_file.close();
         eligible_file.close();
+        self.eligible.InvalidateStatistics();
+    }
+
+    // Derives the time associated debug log filepath if running in debug mode
+    static void SetUpDebugLog(WordleSolver &self)
+    {
+        if (self.debug_mode)
+        {
+            // https://stackoverflow.com/a/16358111
+            auto t{std::time(nullptr)};
+            auto tm{std::localtime(&t)};
+            std::ostringstream oss;
+            oss << std::put_time(tm, "%m-%d-%Y_%H-%M-%S");
+            auto suffix{"-" + oss.str() + WordleSolver::LOG_FP_SUFFIX};
+            self.debug_log_fp = InsertFilePathSuffix(self.dictionary_fp, suffix);
+        }
     }
 
     static void DebugLog(WordleSolver &self, std::string_view message)
@@ -285,24 +577,126 @@ public:
 // Feedback could never be "", also see: https://stackoverflow.com/a/2605559
 const std::string WordleSolver::FEEDBACK_PLACEHOLDER = "";
 
+const std::string WordleSolver::ELIGIBLE_FP_NAME = "eligible.txt";
+
 const std::string WordleSolver::ELIGIBLE_FP_SUFFIX = "-temp";
 
 const std::string WordleSolver::LOG_FP_SUFFIX = "-log";
 
 WordleSolver::WordleSolver(std::string_view d_fp, AbstractRanker *r) : WordleSolver(d_fp, r, false) {}
 
-WordleSolver::WordleSolver(std::string_view d_fp, AbstractRanker *r, bool dm) : num_guesses(0), ranker(r), dictionary_fp(d_fp), eligible_fp(InsertFilePathSuffix(dictionary_fp, WordleSolver::ELIGIBLE_FP_SUFFIX)), debug_mode(dm)
+WordleSolver::WordleSolver(std::string_view d_fp, AbstractRanker *r, bool dm) : WordleSolver(d_fp, r, dm, false) {}
+
+WordleSolver::WordleSolver(std::string_view d_fp, AbstractRanker *r, bool dm, bool fb) : WordleSolver(d_fp, r, dm, fb, fb ? ScratchDirectory::GetDefaultParent() : "") {}
+
+WordleSolver::WordleSolver(std::string_view d_fp, AbstractRanker *r, bool dm, bool fb, std::string_view scratch_parent) : dictionary_fp(d_fp),
+                                                                                                                          dictionary(fb ? nullptr : std::make_shared<const Dictionary>(dictionary_fp)),
+                                                                                                                          ranker(r),
+                                                                                                                          num_guesses(0),
+                                                                                                                          scratch(fb ? std::make_unique<ScratchDirectory>(scratch_parent) : nullptr),
+                                                                                                                          eligible(fb ? EligibleWords(scratch->GetFilePath(WordleSolver::ELIGIBLE_FP_NAME)) : EligibleWords(dictionary.get())),
+                                                                                                                          prev_guess_id(0),
+                                                                                                                          hard_mode(true),
+                                                                                                                          lazy_opening(false),
+                                                                                                                          eligible_fingerprint(0),
+                                                                                                                          in_opening(false),
+                                                                                                                          debug_mode(dm)
+{
+    Private::SetUpDebugLog(*this);
+}
+
+WordleSolver::WordleSolver(std::shared_ptr<const Dictionary> d, AbstractRanker *r, bool dm) : dictionary_fp(d->GetFilePath()),
+                                                                                             dictionary(d),
+                                                                                             ranker(r),
+                                                                                             num_guesses(0),
+                                                                                             eligible(dictionary.get()),
+                                                                                             prev_guess_id(0),
+                                                                                             hard_mode(true),
+                                                                                             lazy_opening(false),
+                                                                                             eligible_fingerprint(0),
+                                                                                             in_opening(false),
+                                                                                             debug_mode(dm)
+{
+    Private::SetUpDebugLog(*this);
+}
+
+void WordleSolver::SetFeedbackMatrix(std::shared_ptr<const FeedbackMatrix> m)
+{
+    if (!eligible.IsInMemory())
+    {
+        throw WordleSolverException("A feedback matrix cannot be used in file-backed mode");
+    }
+    if (m->GetDictionary().GetChecksum() != dictionary->GetChecksum() || m->GetDictionary().Size() != dictionary->Size())
+    {
+        throw WordleSolverException("Feedback matrix was built for a different dictionary than " + dictionary_fp);
+    }
+    feedback_matrix = m;
+}
+
+void WordleSolver::SetHardMode(bool hm)
+{
+    if (!hm && !eligible.IsInMemory())
+    {
+        throw WordleSolverException("Hard mode cannot be turned off in file-backed mode");
+    }
+    hard_mode = hm;
+}
+
+void WordleSolver::SetOpeningBook(std::shared_ptr<OpeningBook> b)
+{
+    SetOpeningBook(b, false);
+}
+
+void WordleSolver::SetOpeningBook(std::shared_ptr<OpeningBook> b, bool lazy)
+{
+    if (!eligible.IsInMemory())
+    {
+        throw WordleSolverException("An opening book cannot be used in file-backed mode");
+    }
+    opening_book = b;
+    lazy_opening = lazy;
+}
+
+WordleSolver::GameState::GameState(const EligibleWords &e, unsigned short ng, const std::string &pg, uint32_t pg_id, bool io) : eligible(e),
+                                                                                                                         num_guesses(ng),
+                                                                                                                         prev_guess(pg),
+                                                                                                                         prev_guess_id(pg_id),
+                                                                                                                         in_opening(io) {}
+
+WordleSolver::GameState WordleSolver::SaveGame() const
 {
-    if (dm)
+    if (!eligible.IsInMemory())
     {
-        // https://stackoverflow.com/a/16358111
-        auto t{std::time(nullptr)};
-        auto tm{std::localtime(&t)};
-        std::ostringstream oss;
-        oss << std::put_time(tm, "%m-%d-%Y_%H-%M-%S");
-        auto suffix{"-" + oss.str() + WordleSolver::LOG_FP_SUFFIX};
-        debug_log_fp = InsertFilePathSuffix(dictionary_fp, suffix);
+        throw WordleSolverException("A game cannot be saved in file-backed mode");
     }
+    return GameState(eligible, num_guesses, prev_guess, prev_guess_id, in_opening);
+}
+
+void WordleSolver::RestoreGame(const GameState &state)
+{
+    eligible = state.eligible;
+    num_guesses = state.num_guesses;
+    prev_guess = state.prev_guess;
+    prev_guess_id = state.prev_guess_id;
+    in_opening = state.in_opening;
+}
+
+void WordleSolver::SetStatisticsCache(std::shared_ptr<FingerprintCache<EligibleStatistics>> c)
+{
+    if (!eligible.IsInMemory())
+    {
+        throw WordleSolverException("A statistics cache cannot be used in file-backed mode");
+    }
+    statistics_cache = c;
+}
+
+void WordleSolver::SetGuessCache(std::shared_ptr<FingerprintCache<std::string>> c)
+{
+    if (!eligible.IsInMemory())
+    {
+        throw WordleSolverException("A guess cache cannot be used in file-backed mode");
+    }
+    guess_cache = c;
 }
 
 std::string WordleSolver::Guess()
@@ -312,13 +706,35 @@ std::string WordleSolver::Guess()
 
 std::string WordleSolver::Guess(std::string_view feedback)
 {
+    return GuessCandidates(feedback, 1).front();
+}
+
+std::vector<std::string> WordleSolver::GuessCandidates(size_t k)
+{
+    return GuessCandidates(FEEDBACK_PLACEHOLDER, k);
+}
+
+std::vector<std::string> WordleSolver::GuessCandidates(std::string_view feedback, size_t k)
+{
+    if (k == 0)
+    {
+        throw WordleSolverException("Must ask for at least 1 guess candidate");
+    }
+
+    // The first two guesses are looked up if possible
+    std::string book_guess;
+    if (k == 1 && Private::GuessFromBook(*this, feedback, book_guess))
+    {
+        return {book_guess};
+    }
+
     // Making initial guess
     if (feedback == FEEDBACK_PLACEHOLDER)
     {
-        // Copy dictionary into eligible words file, reset indices that have been
-        // found and that no guesses have been made (yet)
+        // Copy dictionary into eligible words and reset that no guesses have
+        // been made (yet)
         Private::CopyDictionary(*this);
-        found_indices.clear();
+        Private::UpdateFingerprint(*this);
         num_guesses = 0;
     }
     else // When we have feedback, use it
@@ -330,15 +746,29 @@ std::string WordleSolver::Guess(std::string_view feedback)
         Private::UpdateEligibleWords(*this, feedback);
     }
 
-    // Read-only file stream for eligible words
-    std::ifstream eligible_file(eligible_fp, std::ios_base::in);
-    if (!eligible_file.is_open())
+    // Collect the eligible words before SetUp so invalid file-backed words are
+    // reported before any ranker indexes by letter
+    eligible.GetWords(words, word_texts);
+    if (words.empty())
     {
-        throw WordleSolverException("Could not open eligible words");
+        throw WordleSolverException("Unable to make guess - no eligible words");
+    }
+
+    // Guesses already made with these eligible words are looked up
+    if (k == 1 && Private::GuessFromCache(*this, feedback, book_guess))
+    {
+        return {book_guess};
+    }
+
+    // Probe words go after the eligible words, so ties are broken in favor of
+    // the eligible words
+    if (!hard_mode && words.size() > 2)
+    {
+        Private::AddProbeWords(*this);
     }
 
     // Prepare ranker (part of contract between WordleSolver and AbstractRanker)
-    ranker->SetUp(eligible_fp, num_guesses + 1, feedback);
+    ranker->SetUp(eligible, num_guesses + 1, feedback);
 
     if (debug_mode)
     {
@@ -346,55 +776,53 @@ std::string WordleSolver::Guess(std::string_view feedback)
         Private::DebugLog(*this, ranker->GetDebugInfo());
     }
 
-    // word with rank = current_min_rank
-    std::string current_guess;
-
-    // lowest rank seen so far (every words rank assumed < INT_MAX)
-    int current_min_rank{INT_MAX};
-
-    // rank of current word
-    int current_rank;
-
-    // Read over eligible words line by line and calculate rank, update
-    // current_min_rank and current_guess accordingly
-    std::string word;
-    while (eligible_file.good())
+    // Rank all eligible words with one call to the ranker, only the lowest
+    // rank has to be exact when a single guess is chosen
+    ranks.resize(words.size());
+    if (k == 1 && !debug_mode)
     {
-        std::getline(eligible_file, word);
-        if (word.empty())
-        {
-            // Empty word means we have an empty file (because empty file will have 1 empty line)
-            break;
-        }
+        ranker->RankAll(words, ranks);
+    }
+    else
+    {
+        ranker->RankAllExact(words, ranks);
+    }
 
-        current_rank = ranker->Rank(word);
-        if (debug_mode)
-        {
-            Private::DebugLog(*this, "Eligible: " + word + " rank: " + std::to_string(current_rank));
-        }
-        if (current_rank < current_min_rank)
+    if (debug_mode)
+    {
+        for (size_t i{0}; i < words.size(); i++)
         {
-            current_guess = word;
-            current_min_rank = current_rank;
+            Private::DebugLog(*this, "Eligible: " + std::string(words[i].text) + " rank: " + std::to_string(ranks[i]));
         }
     }
-    eligible_file.close();
 
-    // current_guess was never set in above loop
-    if (current_guess.empty())
+    // Order the k best words by rank, breaking ties by the order of words
+    // (dictionary order, eligible words first)
+    k = std::min(k, words.size());
+    order.resize(words.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [this](uint32_t a, uint32_t b)
+                      { return ranks[a] < ranks[b] || (ranks[a] == ranks[b] && a < b); });
+
+    std::vector<std::string> candidates;
+    candidates.reserve(k);
+    for (size_t i{0}; i < k; i++)
     {
-        throw WordleSolverException("Unable to make guess - no eligible words");
+        candidates.emplace_back(words[order[i]].text);
     }
 
+    Private::CacheResults(*this, feedback, candidates.front());
 
     // Mark we have made guess and store guess to make future guesses
     num_guesses++;
-    prev_guess = current_guess;
+    in_opening = false;
+    prev_guess = candidates.front();
+    prev_guess_id = words[order.front()].id;
 
     if (debug_mode)
     {
-        Private::DebugLog(*this, "Guess " + std::to_string(num_guesses) + ": " + current_guess);
+        Private::DebugLog(*this, "Guess " + std::to_string(num_guesses) + ": " + prev_guess);
     }
 
-    return current_guess;
+    return candidates;
 }
@@ -14,27 +14,43 @@ Date: Summer 2022
 
 #include <exception>
 #include "ranker.h"
+#include "dictionary.h"
+#include "eligible_words.h"
+#include "feedback_matrix.h"
+#include "scratch_directory.h"
+#include "opening_book.h"
+#include "fingerprint_cache.h"
+#include <memory>
 #include <string>
 #include <string_view>
-#include <unordered_set>
+#include <vector>
 
 /*
 Solver for Wordle game.
 
 Uses a dictionary of 5 letter words and a AbstractRanker to guess
 solutions to the Wordle game. Whenever the AbstractRanker is used
-to rank words using AbstractRanker::Rank, it is guaranteed that
-AbstractRanker::SetUp will be called with the filepath to the most
-up to date list of eligible words. Furthermore, it is guaranteed
+to rank words using AbstractRanker::RankAll (or RankAllExact), it is
+guaranteed that AbstractRanker::SetUp will be called with the filepath
+to the most up to date set of eligible words. Furthermore, it is guaranteed
 when run in debug mode that AbstractRanker::GetDebugInfo will be
 called after AbstractRanker::SetUp. These conditions make up
 a contract between WordleSolver and AbstractRanker that will
 allow for the design of derived classes of AbstractRanker.
 
-The WordleSolver solves the game following the hard mode requirements,
-that is that words that fail to match the prior feedback are no
+By default, the WordleSolver solves the game following the hard mode
+requirements, that is that words that fail to match the prior feedback are no
 longer eligible to be guesses. For instance, the game would never
-guess "audio" after receiving the feedback "bgggg" for "creed".
+guess "audio" after receiving the feedback "bgggg" for "creed". Outside hard
+mode (see SetHardMode), any dictionary word can be guessed to learn more about
+the eligible words, while only the eligible words can still be the solution.
+
+By default, the dictionary is loaded into memory once and the eligible
+words are tracked as ids into it, so processing feedback does no file
+I/O. For dictionaries that do not fit in memory, the solver can instead
+keep the eligible words in a file (file-backed mode). Each file-backed
+solver uses its own scratch directory, so any number of solvers can run at
+once on the same dictionary, in threads or in separate processes.
 */
 class WordleSolver
 {
@@ -74,6 +90,174 @@ public:
     */
     WordleSolver(std::string_view d_fp, AbstractRanker *r, bool dm);
 
+    /*
+    Creates a WordleSolver given a dictionary, ranking scheme, debug mode setting, and storage mode.
+
+    Parameters:
+        d_fp : Path to dictionary file. Dictionary file should have
+        a 5-letter word set that is a superset of the wordle words.
+        Each word should be on a separate line.
+
+        r : Pointer to AbstractRanker that points to a derived class
+        object that implements a ranking scheme.
+
+        dm : Debug mode.
+
+        fb : File-backed mode. If true, the dictionary is never loaded into
+        memory and the eligible words are stored in a file that is rewritten
+        as feedback is processed. This is much slower and should only be used
+        with dictionaries that do not fit in memory. The file is kept in a
+        ScratchDirectory of the solver's own in the default location (see
+        ScratchDirectory()) that is removed when the solver is destroyed.
+    */
+    WordleSolver(std::string_view d_fp, AbstractRanker *r, bool dm, bool fb);
+
+    /*
+    Overloaded version of WordleSolver(std::string_view,AbstractRanker*,bool,bool) that chooses where file-backed scratch files go.
+
+    Parameters:
+        d_fp : Path to dictionary file. Dictionary file should have
+        a 5-letter word set that is a superset of the wordle words.
+        Each word should be on a separate line.
+
+        r : Pointer to AbstractRanker that points to a derived class
+        object that implements a ranking scheme.
+
+        dm : Debug mode.
+
+        fb : File-backed mode.
+
+        scratch_parent : Existing directory in which the solver creates its
+        ScratchDirectory in file-backed mode (unused otherwise).
+    */
+    WordleSolver(std::string_view d_fp, AbstractRanker *r, bool dm, bool fb, std::string_view scratch_parent);
+
+    /*
+    Creates an in-memory WordleSolver that uses an already loaded dictionary.
+
+    This allows many solvers (e.g. in GridEvaluate) to share one Dictionary.
+
+    Parameters:
+        d : Dictionary that is a superset of the wordle words.
+
+        r : Pointer to AbstractRanker that points to a derived class
+        object that implements a ranking scheme.
+
+        dm : Debug mode.
+    */
+    WordleSolver(std::shared_ptr<const Dictionary> d, AbstractRanker *r, bool dm);
+
+    /*
+    Makes the solver use a precomputed FeedbackMatrix.
+
+    When set, feedback is processed by looking up the feedback code of the
+    previous guess against each eligible word instead of checking a
+    FeedbackConstraint.
+
+    Parameters:
+        m : FeedbackMatrix built for the solver's dictionary.
+
+    Throws:
+        WordleSolverException if the solver is file-backed or m was built for
+        a different dictionary.
+    */
+    void SetFeedbackMatrix(std::shared_ptr<const FeedbackMatrix> m);
+
+    /*
+    Sets whether the solver plays in hard mode (the default).
+
+    Outside hard mode, the ranker also ranks dictionary words that are no
+    longer eligible (probe words), so it may choose a guess that cannot be the
+    solution but splits the eligible words better. Probe words whose every
+    letter would get the same color whichever eligible word is the solution
+    give no information and are never ranked. Eligible words are preferred
+    over probe words with the same rank, and once at most 2 words are eligible
+    only they are ranked. This only helps with rankers that measure how a guess
+    splits the eligible words (see PartitionRanker), frequency based rankers
+    may choose probe words that make no progress.
+
+    Parameters:
+        hm : Hard mode.
+
+    Throws:
+        WordleSolverException if hm is false and the solver is file-backed.
+    */
+    void SetHardMode(bool hm);
+
+    /*
+    Makes the solver use an OpeningBook.
+
+    When set, and the ranker is deterministic (see AbstractRanker::IsDeterministic),
+    the first and second guesses are looked up in the book rather than ranked
+    (the ranker's SetUp is not called for them). The first time a game starts
+    without an opening for the dictionary, ranker, and mode in the book, the
+    first guess and the second guess for every possible feedback are ranked and
+    added to the book (see SetOpeningBook(std::shared_ptr<OpeningBook>,bool)
+    to add them as they are needed instead). The book is not used in debug mode or by GuessCandidates
+    with k > 1.
+
+    Parameters:
+        b : Book to use (may be shared with other solvers).
+
+    Throws:
+        WordleSolverException if the solver is file-backed.
+    */
+    void SetOpeningBook(std::shared_ptr<OpeningBook> b);
+
+    /*
+    Overloaded version of SetOpeningBook that can fill the book lazily.
+
+    A lazily filled opening starts with only the first guess, and the second
+    guess for a feedback is ranked and added to the book the first time that
+    feedback is received. So, the first game without an opening ranks no more
+    than a game without a book (e.g. in RunUserMode), at the cost of the later
+    games only looking up the second guesses seen so far.
+
+    Parameters:
+        b : Book to use (may be shared with other solvers).
+        lazy : Whether openings are filled lazily.
+
+    Throws:
+        WordleSolverException if the solver is file-backed.
+    */
+    void SetOpeningBook(std::shared_ptr<OpeningBook> b, bool lazy);
+
+    /*
+    Makes the solver share the statistics of eligible words through a cache.
+
+    When set, the statistics of the eligible words after feedback (see
+    EligibleWords::GetStatistics) are looked up by the words' fingerprint
+    before they are updated or computed, and are added to the cache once a
+    ranker has computed them. So solvers (with any rankers) that reach the same
+    eligible words only compute their statistics once.
+
+    Parameters:
+        c : Cache to use (may be shared with other solvers of any dictionary).
+
+    Throws:
+        WordleSolverException if the solver is file-backed.
+    */
+    void SetStatisticsCache(std::shared_ptr<FingerprintCache<EligibleStatistics>> c);
+
+    /*
+    Makes the solver reuse guesses through a cache.
+
+    When set, and the ranker is deterministic (see AbstractRanker::IsDeterministic),
+    a guess is looked up by the fingerprint of the eligible words combined with
+    the ranker's name, the guess number, the feedback, and the mode before it
+    is ranked (the ranker's SetUp is not called if it is found). Ranked guesses
+    are added to the cache. The cache is not used in debug mode or by
+    GuessCandidates with k > 1.
+
+    Parameters:
+        c : Cache to use (may be shared with other solvers of any dictionary
+        and ranker).
+
+    Throws:
+        WordleSolverException if the solver is file-backed.
+    */
+    void SetGuessCache(std::shared_ptr<FingerprintCache<std::string>> c);
+
     /*
     Returns an initial guess.
     */
@@ -91,14 +275,94 @@ public:
     */
     std::string Guess(std::string_view feedback);
 
-private:
     /*
-    Filepath to the dictionary used to make guesses. The dictionary is stored
-    in a file versus a container so as to not assume that the dictionary can
-    fit in memory.
+    Returns the best initial guesses.
+
+    Parameters:
+        k: Maximum number of guesses to return (at least 1).
+
+    Returns:
+        See GuessCandidates(std::string_view,size_t).
+    */
+    std::vector<std::string> GuessCandidates(size_t k);
+
+    /*
+    Makes a guess based on the most recent guess and feedback, returning the best candidates.
+
+    Candidates are ordered by rank (lowest first). Words with equal rank are
+    ordered by their position in the dictionary, so the result is always the
+    same for the same eligible words and ranks. The first candidate is the
+    guess (it is what Guess(std::string_view) would return) and the solver
+    continues from it.
+
+    Parameters:
+        feedback: Feedback for the previous guess (see Guess(std::string_view)).
+        k: Maximum number of candidates to return (at least 1).
+
+    Returns:
+        The k best eligible words (fewer if fewer words are eligible). Outside
+        hard mode, probe words can be candidates too (see SetHardMode).
+
+    Throws:
+        WordleSolverException if k is 0 or no words are eligible.
+    */
+    std::vector<std::string> GuessCandidates(std::string_view feedback, size_t k);
+
+    /*
+    Progress of an in-memory game: the eligible words, the number of guesses
+    made, and the previous guess. It can only be created by SaveGame and used
+    by RestoreGame.
+    */
+    class GameState
+    {
+    private:
+        friend class WordleSolver;
+
+        GameState(const EligibleWords &e, unsigned short ng, const std::string &pg, uint32_t pg_id, bool io);
+
+        EligibleWords eligible;
+        unsigned short num_guesses;
+        std::string prev_guess;
+        uint32_t prev_guess_id;
+        bool in_opening;
+    };
+
+    /*
+    Saves the progress of the current game.
+
+    With a deterministic ranker (see AbstractRanker::IsDeterministic), the next
+    guess only depends on the progress of the game and the feedback, so a game
+    can be continued with different feedback by restoring it. This is cheaper
+    than replaying the game's guesses.
+
+    Returns:
+        The progress of the game, to be passed to RestoreGame.
+
+    Throws:
+        WordleSolverException if the solver is file-backed.
     */
+    GameState SaveGame() const;
+
+    /*
+    Restores the progress of a game, the next call to Guess(std::string_view)
+    continues from it.
+
+    Parameters:
+        state: Progress saved by SaveGame on this solver (with the same hard
+        mode and opening book).
+    */
+    void RestoreGame(const GameState &state);
+
+private:
+    // Filepath to the dictionary used to make guesses.
     std::string dictionary_fp;
 
+    /*
+    Dictionary loaded from dictionary_fp. This is nullptr in file-backed mode
+    so as to not assume that the dictionary can fit in memory.
+    */
+    std::shared_ptr<const Dictionary> dictionary;
+
     /*
     Pointer to the AbstractRanker used to make guesses. Pointer combined with
     virtual AbstractRanker functions enables dynamic binding.
@@ -112,19 +376,15 @@ private:
     */
     unsigned short num_guesses;
 
-    /*
-    Set of the indices (0-4) of the solution that have been found so far.
-    */
-    std::unordered_set<unsigned short> found_indices;
+    // Directory holding the eligible words files in file-backed mode (nullptr in memory)
+    std::unique_ptr<ScratchDirectory> scratch;
 
     /*
-    Filepath to where the eligible words from the dictionary will be stored.
-    These will be the words that remain after processing feedback. A separate
-    file is used as to not overwrite the dictionary filepath. The eligible words
-    are stored in a file because initially it may not fit in the memory as it
-    starts as the dictionary.
+    The words that remain after processing feedback. In memory, these are ids
+    into dictionary. In file-backed mode, these are stored in a file in scratch
+    (a separate file is used as to not overwrite the dictionary filepath).
     */
-    std::string eligible_fp;
+    EligibleWords eligible;
 
     /*
     Stores the previous guess made by the solver. Starts as the empty string as
@@ -132,6 +392,51 @@ private:
     */
     std::string prev_guess;
 
+    // Id of prev_guess in dictionary (only used in memory)
+    uint32_t prev_guess_id;
+
+    // Optional precomputed feedback for dictionary (nullptr if not used)
+    std::shared_ptr<const FeedbackMatrix> feedback_matrix;
+
+    // Buffers reused by every guess to rank the eligible words as a batch:
+    // the words, the letters of file-backed words, their ranks and the order
+    // of the words by rank
+    std::vector<Word> words;
+    std::vector<std::string> word_texts;
+    std::vector<int> ranks;
+    std::vector<uint32_t> order;
+
+    // Whether only eligible words are guessed (see SetHardMode)
+    bool hard_mode;
+
+    // Optional book of openings (nullptr if not used)
+    std::shared_ptr<OpeningBook> opening_book;
+
+    // Whether openings are added to the book one guess at a time (see SetOpeningBook)
+    bool lazy_opening;
+
+    // Optional caches of statistics and guesses by fingerprint (nullptr if not used)
+    std::shared_ptr<FingerprintCache<EligibleStatistics>> statistics_cache;
+    std::shared_ptr<FingerprintCache<std::string>> guess_cache;
+
+    // Fingerprint of the eligible words after the latest feedback (only set
+    // when a cache is used)
+    uint64_t eligible_fingerprint;
+
+    // Opening of the current game and whether the game has followed it so far
+    OpeningBook::Opening opening;
+    bool in_opening;
+
+    // is_eligible[id] is whether dictionary word id is eligible (only used
+    // outside hard mode to find the probe words)
+    std::vector<bool> is_eligible;
+
+    // Buffers holding the eligible words from before the latest feedback, used
+    // to update their statistics with only the removed words
+    std::vector<uint32_t> prev_ids;
+    std::vector<uint32_t> prev_codes;
+    std::vector<uint32_t> prev_masks;
+
     /*
     Inner class that holds private helper functions of WordleSolver. See
     https://stackoverflow.com/a/28734794.
@@ -144,9 +449,12 @@ private:
     */
     static const std::string FEEDBACK_PLACEHOLDER;
 
+    // Stores the name of the eligible words file in scratch.
+    static const std::string ELIGIBLE_FP_NAME;
+
     /*
-    Stores the suffix appended to the dictionary filepath before the extension
-    for the eligible words file.
+    Stores the suffix appended to the eligible words filepath before the extension
+    for the temporary file used to reduce the eligible words.
     */
     static const std::string ELIGIBLE_FP_SUFFIX;
 
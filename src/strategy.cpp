@@ -0,0 +1,409 @@
+// Implementation of strategy.h
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "strategy.h"
+#include "solver.h"
+#include "feedback.h"
+#include "thread_pool.h"
+#include "opening_book.h"
+#include "fingerprint_cache.h"
+#include "misc.h"
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <numeric>
+
+// Header at the start of a strategy file, followed by the ranker name, the
+// guesses, the edge begins, the edge codes, and the edge children
+struct StrategyHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t num_words;
+    uint64_t dictionary_checksum;
+    uint32_t num_nodes;
+    uint32_t num_edges;
+    uint32_t name_length;
+    uint32_t hard_mode;
+};
+
+// Identifies strategy files, version is increased if the layout changes
+static const char STRATEGY_MAGIC[8]{'W', 'S', 'S', 'T', 'R', 'A', 'T', '\0'};
+static const uint32_t STRATEGY_VERSION{1};
+
+class Strategy::Private
+{
+public:
+    // A state reached by the walk, the guess number is the length of path + 1
+    struct State
+    {
+        // Ids of the eligible words (in increasing order)
+        std::vector<uint32_t> ids;
+
+        // Feedback codes received so far
+        std::vector<uint8_t> path;
+    };
+
+    // FNV-1a hash of a state's eligible words and what its ranker SetUp receives
+    static uint64_t Fingerprint(const State &state)
+    {
+        uint64_t hash{14695981039346656037ull};
+        auto mix{[&hash](uint64_t value)
+                 {
+                     hash ^= value;
+                     hash *= 1099511628211ull;
+                 }};
+        for (auto id : state.ids)
+        {
+            mix(id);
+        }
+        mix(state.path.size());
+        mix(state.path.empty() ? NUM_FEEDBACK_CODES : state.path.back());
+        return hash;
+    }
+
+    // Computes the guess the solver makes in state by replaying its path (the
+    // solver's opening book and guess cache make the earlier guesses lookups)
+    static uint32_t GetGuess(const Strategy &self, WordleSolver &solver, const State &state)
+    {
+        // With one eligible word, it is the guess in either mode
+        if (state.ids.size() == 1)
+        {
+            return state.ids.front();
+        }
+
+        auto guess{solver.Guess()};
+        for (auto code : state.path)
+        {
+            guess = solver.Guess(DecodeFeedback(code));
+        }
+
+        uint32_t id;
+        if (!self.dictionary->Find(guess, id))
+        {
+            throw WordleSolverException("Guess [" + guess + "] is not in the dictionary");
+        }
+        return id;
+    }
+
+    // Walks every state reachable by the solver, one guess number at a time
+    static void Build(Strategy &self, AbstractRanker *r, size_t num_threads)
+    {
+        ThreadPool pool(num_threads);
+
+        // Every worker plays with its own solver (and ranker clone), all of them
+        // share an opening book and a guess cache so replaying a path only ranks
+        // its last guess
+        auto book{std::make_shared<OpeningBook>()};
+        const size_t GUESS_CACHE_CAPACITY{1 << 16};
+        auto guess_cache{std::make_shared<FingerprintCache<std::string>>(GUESS_CACHE_CAPACITY)};
+        std::vector<std::unique_ptr<AbstractRanker>> rankers;
+        std::vector<std::unique_ptr<WordleSolver>> solvers;
+        for (size_t w{0}; w < pool.Size(); w++)
+        {
+            rankers.push_back(r->Clone());
+            solvers.push_back(std::make_unique<WordleSolver>(self.dictionary, rankers.back().get(), false));
+            solvers.back()->SetHardMode(self.hard_mode);
+            solvers.back()->SetOpeningBook(book);
+            solvers.back()->SetGuessCache(guess_cache);
+        }
+
+        auto codes{self.dictionary->GetCodes()};
+        std::vector<State> level(1);
+        level.front().ids.resize(self.dictionary->Size());
+        std::iota(level.front().ids.begin(), level.front().ids.end(), 0);
+
+        // Edges are found a level after their node's guess, so they are first
+        // collected per node
+        std::vector<std::vector<std::pair<uint8_t, uint32_t>>> node_edges;
+        for (unsigned short guess_number{1}; !level.empty(); guess_number++)
+        {
+            auto first_node{static_cast<uint32_t>(self.guesses.size())};
+            self.guesses.resize(first_node + level.size());
+            node_edges.resize(self.guesses.size());
+            pool.ParallelFor(level.size(), [&self, &solvers, &level, first_node](size_t i, size_t worker)
+                             { self.guesses[first_node + i] = GetGuess(self, *solvers[worker], level[i]); });
+
+            if (guess_number == MAX_GUESSES)
+            {
+                break;
+            }
+
+            // Split each state's words by the feedback they give its guess, states
+            // already seen on this level are reused
+            std::vector<State> next_level;
+            std::unordered_multimap<uint64_t, uint32_t> seen;
+            for (size_t i{0}; i < level.size(); i++)
+            {
+                auto node{first_node + static_cast<uint32_t>(i)};
+                auto guess_code{codes[self.guesses[node]]};
+                std::vector<uint32_t> groups[NUM_FEEDBACK_CODES];
+                for (auto id : level[i].ids)
+                {
+                    groups[GetFeedbackCode(guess_code, codes[id])].push_back(id);
+                }
+
+                for (size_t c{0}; c < NUM_FEEDBACK_CODES; c++)
+                {
+                    if (groups[c].empty() || c == ALL_GREEN_CODE)
+                    {
+                        continue;
+                    }
+
+                    State child{std::move(groups[c]), level[i].path};
+                    child.path.push_back(static_cast<uint8_t>(c));
+                    auto fingerprint{Fingerprint(child)};
+                    auto child_node{Strategy::ROOT};
+                    auto found{false};
+                    auto range{seen.equal_range(fingerprint)};
+                    for (auto itr{range.first}; itr != range.second && !found; itr++)
+                    {
+                        const auto &other{next_level[itr->second]};
+                        if (other.ids == child.ids && other.path.back() == child.path.back())
+                        {
+                            child_node = static_cast<uint32_t>(self.guesses.size() + itr->second);
+                            found = true;
+                        }
+                    }
+                    if (!found)
+                    {
+                        seen.emplace(fingerprint, static_cast<uint32_t>(next_level.size()));
+                        child_node = static_cast<uint32_t>(self.guesses.size() + next_level.size());
+                        next_level.push_back(std::move(child));
+                    }
+                    node_edges[node].emplace_back(static_cast<uint8_t>(c), child_node);
+                }
+            }
+            level = std::move(next_level);
+        }
+
+        self.edge_begins.push_back(0);
+        for (size_t n{0}; n < self.guesses.size(); n++)
+        {
+            for (const auto &[code, child] : node_edges[n])
+            {
+                self.edge_codes.push_back(code);
+                self.edge_children.push_back(child);
+            }
+            self.edge_begins.push_back(static_cast<uint32_t>(self.edge_codes.size()));
+        }
+    }
+
+    // Reads the parts of a strategy file into self
+    static void Load(Strategy &self, const std::string &strategy_fp)
+    {
+        std::ifstream strategy_file(strategy_fp, std::ios_base::in | std::ios_base::binary);
+        if (!strategy_file.is_open())
+        {
+            throw WordleSolverException("Could not open " + strategy_fp + " for reading");
+        }
+
+        StrategyHeader header;
+        strategy_file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!strategy_file || std::memcmp(header.magic, STRATEGY_MAGIC, sizeof(STRATEGY_MAGIC)) != 0 || header.version != STRATEGY_VERSION)
+        {
+            throw WordleSolverException(strategy_fp + " is not a strategy file");
+        }
+        if (header.num_words != self.dictionary->Size() || header.dictionary_checksum != self.dictionary->GetChecksum())
+        {
+            throw WordleSolverException(strategy_fp + " was built for a different dictionary than " + self.dictionary->GetFilePath());
+        }
+
+        // The counts in the header are checked against the file size before
+        // anything is allocated, so a corrupt header cannot ask for GBs
+        std::error_code error;
+        auto file_size{std::filesystem::file_size(strategy_fp, error)};
+        if (error || file_size != FileSize(header))
+        {
+            throw WordleSolverException(strategy_fp + " is truncated or has a corrupt header");
+        }
+
+        self.ranker_name.resize(header.name_length);
+        self.hard_mode = header.hard_mode != 0;
+        self.guesses.resize(header.num_nodes);
+        self.edge_begins.resize(header.num_nodes + 1);
+        self.edge_codes.resize(header.num_edges);
+        self.edge_children.resize(header.num_edges);
+        Read(strategy_file, self.ranker_name.data(), self.ranker_name.size());
+        Read(strategy_file, self.guesses.data(), self.guesses.size());
+        Read(strategy_file, self.edge_begins.data(), self.edge_begins.size());
+        Read(strategy_file, self.edge_codes.data(), self.edge_codes.size());
+        Read(strategy_file, self.edge_children.data(), self.edge_children.size());
+        if (!strategy_file)
+        {
+            throw WordleSolverException(strategy_fp + " is truncated");
+        }
+        if (!IsValid(self))
+        {
+            throw WordleSolverException(strategy_fp + " is not a valid strategy for " + self.dictionary->GetFilePath());
+        }
+    }
+
+    // Computes the size of a strategy file from its header (the counts are 32
+    // bit, so this cannot overflow)
+    static uint64_t FileSize(const StrategyHeader &header)
+    {
+        return sizeof(StrategyHeader) +
+               uint64_t{header.name_length} * sizeof(char) +
+               uint64_t{header.num_nodes} * sizeof(uint32_t) +
+               (uint64_t{header.num_nodes} + 1) * sizeof(uint32_t) +
+               uint64_t{header.num_edges} * (sizeof(uint8_t) + sizeof(uint32_t));
+    }
+
+    // Checks that the tree read by Load only refers to its own nodes and edges
+    // and to words of the dictionary
+    static bool IsValid(const Strategy &self)
+    {
+        auto num_nodes{self.guesses.size()};
+        auto num_edges{self.edge_codes.size()};
+        if (num_nodes == 0 || self.edge_begins.front() != 0 || self.edge_begins.back() != num_edges)
+        {
+            return false;
+        }
+        for (size_t n{0}; n < num_nodes; n++)
+        {
+            if (self.guesses[n] >= self.dictionary->Size() || self.edge_begins[n] > self.edge_begins[n + 1])
+            {
+                return false;
+            }
+        }
+        for (size_t k{0}; k < num_edges; k++)
+        {
+            if (self.edge_codes[k] >= NUM_FEEDBACK_CODES || self.edge_children[k] >= num_nodes)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Reads n values into data
+    template <typename T>
+    static void Read(std::ifstream &file, T *data, size_t n)
+    {
+        file.read(reinterpret_cast<char *>(data), n * sizeof(T));
+    }
+
+    // Writes n values from data
+    template <typename T>
+    static void Write(std::ofstream &file, const T *data, size_t n)
+    {
+        file.write(reinterpret_cast<const char *>(data), n * sizeof(T));
+    }
+};
+
+Strategy::Strategy(std::shared_ptr<const Dictionary> d, AbstractRanker *r, bool hard_mode, size_t num_threads) : dictionary(d), ranker_name(r->GetName()), hard_mode(hard_mode)
+{
+    if (!r->IsDeterministic())
+    {
+        throw WordleSolverException("A strategy cannot be built with " + ranker_name + " as it is not deterministic");
+    }
+    Private::Build(*this, r, num_threads);
+}
+
+Strategy::Strategy(std::shared_ptr<const Dictionary> d, const std::string &strategy_fp) : dictionary(d), hard_mode(true)
+{
+    Private::Load(*this, strategy_fp);
+}
+
+void Strategy::Save(const std::string &strategy_fp) const
+{
+    // A temporary file is renamed into place so another process never loads
+    // a partially written strategy
+    auto temp_fp{GetTempFilePath(strategy_fp)};
+    std::ofstream strategy_file(temp_fp, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!strategy_file.is_open())
+    {
+        throw WordleSolverException("Could not open " + temp_fp + " for writing");
+    }
+
+    StrategyHeader header{};
+    std::memcpy(header.magic, STRATEGY_MAGIC, sizeof(STRATEGY_MAGIC));
+    header.version = STRATEGY_VERSION;
+    header.num_words = static_cast<uint32_t>(dictionary->Size());
+    header.dictionary_checksum = dictionary->GetChecksum();
+    header.num_nodes = static_cast<uint32_t>(guesses.size());
+    header.num_edges = static_cast<uint32_t>(edge_codes.size());
+    header.name_length = static_cast<uint32_t>(ranker_name.size());
+    header.hard_mode = hard_mode;
+    Private::Write(strategy_file, &header, 1);
+    Private::Write(strategy_file, ranker_name.data(), ranker_name.size());
+    Private::Write(strategy_file, guesses.data(), guesses.size());
+    Private::Write(strategy_file, edge_begins.data(), edge_begins.size());
+    Private::Write(strategy_file, edge_codes.data(), edge_codes.size());
+    Private::Write(strategy_file, edge_children.data(), edge_children.size());
+    strategy_file.close();
+    if (!strategy_file)
+    {
+        std::error_code error;
+        std::filesystem::remove(temp_fp, error);
+        throw WordleSolverException("Could not write " + temp_fp);
+    }
+
+    ReplaceFile(temp_fp, strategy_fp);
+}
+
+const Dictionary &Strategy::GetDictionary() const
+{
+    return *dictionary;
+}
+
+const std::string &Strategy::GetRankerName() const
+{
+    return ranker_name;
+}
+
+bool Strategy::IsHardMode() const
+{
+    return hard_mode;
+}
+
+size_t Strategy::Size() const
+{
+    return guesses.size();
+}
+
+uint32_t Strategy::GetGuess(uint32_t node) const
+{
+    return guesses[node];
+}
+
+bool Strategy::GetChild(uint32_t node, uint8_t feedback_code, uint32_t &child) const
+{
+    auto begin{edge_codes.begin() + edge_begins[node]};
+    auto end{edge_codes.begin() + edge_begins[node + 1]};
+    auto itr{std::lower_bound(begin, end, feedback_code)};
+    if (itr == end || *itr != feedback_code)
+    {
+        return false;
+    }
+    child = edge_children[itr - edge_codes.begin()];
+    return true;
+}
+
+std::string Strategy::GetDefaultFilePath(const std::string &dictionary_fp)
+{
+    std::filesystem::path strategy_path{dictionary_fp};
+    auto stem{strategy_path.stem().string()};
+    return strategy_path.replace_filename(stem + "-strategy.bin").string();
+}
+
+StrategySolver::StrategySolver(std::shared_ptr<const Strategy> s) : strategy(s), node(Strategy::ROOT) {}
+
+std::string StrategySolver::Guess()
+{
+    node = Strategy::ROOT;
+    return std::string(strategy->GetDictionary()[strategy->GetGuess(node)]);
+}
+
+std::string StrategySolver::Guess(std::string_view feedback)
+{
+    if (!strategy->GetChild(node, EncodeFeedback(feedback), node))
+    {
+        throw WordleSolverException("Unable to make guess - strategy has no guess after feedback " + std::string(feedback));
+    }
+    return std::string(strategy->GetDictionary()[strategy->GetGuess(node)]);
+}
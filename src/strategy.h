@@ -0,0 +1,211 @@
+/*
+Header for strategies.
+
+This file declares the Strategy class which stores every guess a WordleSolver
+would make as a decision tree, and StrategySolver which plays by following a
+Strategy.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "dictionary.h"
+#include "ranker.h"
+
+/*
+Decision tree of the guesses a WordleSolver makes.
+
+With a deterministic ranker (see AbstractRanker::IsDeterministic), the guess
+a solver makes only depends on the eligible words, the guess number, and the
+feedback on the previous guess (what the ranker's SetUp receives). So every
+game the solver can play is a path through one tree. Each node holds a guess
+and has a child for each feedback (other than all green) that leaves some
+words eligible, while at most 6 guesses are made.
+
+The tree is built by walking all reachable states level by level, computing
+the guesses of a level in parallel. States with the same eligible words,
+guess number, and feedback are only visited once (so the tree may share
+nodes). It can be saved to a compact binary file (a guess id and a list of
+(feedback code, child) pairs per node) and loaded again, so the solver's
+play can be replayed or evaluated without any ranking.
+*/
+class Strategy
+{
+public:
+    // Index of the first node (holding the first guess)
+    static const uint32_t ROOT{0};
+
+    // Most guesses made in a game
+    static const unsigned short MAX_GUESSES{6};
+
+    /*
+    Builds the strategy of a solver.
+
+    Parameters:
+        d: Dictionary the solver uses.
+        r: Deterministic ranker the solver uses. Only clones of it are used
+           (see AbstractRanker::Clone) so it is not modified.
+        hard_mode: Whether the solver is in hard mode (see WordleSolver::SetHardMode).
+        num_threads: Threads used to compute the guesses (0 for one per
+                     hardware thread, 1 for the calling thread only).
+
+    Throws:
+        WordleSolverException if r is not deterministic.
+    */
+    Strategy(std::shared_ptr<const Dictionary> d, AbstractRanker *r, bool hard_mode, size_t num_threads);
+
+    /*
+    Loads a strategy from a file.
+
+    Parameters:
+        d: Dictionary the strategy was built for.
+        strategy_fp: Path to a file written by Save.
+
+    Throws:
+        WordleSolverException if strategy_fp cannot be read, is not a strategy
+        file, was built for a different dictionary, has a size that does not
+        match its header, or holds edges or guesses outside the tree or the
+        dictionary.
+    */
+    Strategy(std::shared_ptr<const Dictionary> d, const std::string &strategy_fp);
+
+    /*
+    Saves the strategy to a file. It is written to a temporary file that then
+    replaces strategy_fp (see ReplaceFile).
+
+    Parameters:
+        strategy_fp: Path to the file.
+
+    Throws:
+        WordleSolverException if strategy_fp cannot be written.
+    */
+    void Save(const std::string &strategy_fp) const;
+
+    // Dictionary the strategy was built for.
+    const Dictionary &GetDictionary() const;
+
+    // Name of the ranker the strategy was built with.
+    const std::string &GetRankerName() const;
+
+    // Whether the strategy was built in hard mode.
+    bool IsHardMode() const;
+
+    // Number of nodes in the tree.
+    size_t Size() const;
+
+    /*
+    Gets the guess of a node.
+
+    Parameters:
+        node: Index of the node, not bounds checked.
+
+    Returns:
+        Id of the guess in the dictionary.
+    */
+    uint32_t GetGuess(uint32_t node) const;
+
+    /*
+    Gets the child of a node for some feedback.
+
+    Parameters:
+        node: Index of the node, not bounds checked.
+        feedback_code: Feedback on the guess of node (see EncodeFeedback).
+        child: Will store the index of the child if there is one.
+
+    Returns:
+        true if node has a child for feedback_code, false otherwise (the
+        feedback leaves no word eligible, is all green, or would need a 7th
+        guess).
+    */
+    bool GetChild(uint32_t node, uint8_t feedback_code, uint32_t &child) const;
+
+    /*
+    Gets the default path of the strategy file for a dictionary.
+
+    Parameters:
+        dictionary_fp: Path to a dictionary file.
+
+    Returns:
+        Path with the extension replaced, e.g. "a.txt" -> "a-strategy.bin".
+    */
+    static std::string GetDefaultFilePath(const std::string &dictionary_fp);
+
+private:
+    /*
+    Inner class that holds private helper functions of Strategy. See
+    https://stackoverflow.com/a/28734794.
+    */
+    class Private;
+
+    // Dictionary the strategy was built for
+    std::shared_ptr<const Dictionary> dictionary;
+
+    // Name of the ranker and mode the strategy was built with
+    std::string ranker_name;
+    bool hard_mode;
+
+    // guesses[n] is the id of the guess of node n
+    std::vector<uint32_t> guesses;
+
+    // The children of node n are edges edge_begins[n]...edge_begins[n + 1] - 1,
+    // edge k leads to node edge_children[k] on feedback edge_codes[k] (in
+    // increasing order of code)
+    std::vector<uint32_t> edge_begins;
+    std::vector<uint8_t> edge_codes;
+    std::vector<uint32_t> edge_children;
+};
+
+/*
+Solver that plays by following a Strategy.
+
+It makes the same guesses as the WordleSolver the strategy was built from,
+but each guess is only a step down the tree.
+*/
+class StrategySolver
+{
+public:
+    /*
+    Creates a StrategySolver.
+
+    Parameters:
+        s: Strategy to follow (may be shared with other solvers).
+    */
+    StrategySolver(std::shared_ptr<const Strategy> s);
+
+    /*
+    Returns an initial guess.
+    */
+    std::string Guess();
+
+    /*
+    Makes a guess based on the most recent guess and feedback.
+
+    Parameters:
+        feedback: Feedback for the previous output of Guess() (see WordleSolver::Guess(std::string_view)).
+
+    Returns:
+        The newest guess.
+
+    Throws:
+        WordleSolverException if the strategy has no guess after feedback (no
+        word is eligible or 6 guesses have been made).
+    */
+    std::string Guess(std::string_view feedback);
+
+private:
+    // Strategy being followed
+    std::shared_ptr<const Strategy> strategy;
+
+    // Node of the most recent guess
+    uint32_t node;
+};
+
+#endif
@@ -0,0 +1,186 @@
+// Implementation of ThreadPool
+// Author: Chami Lamelas
+// Date: Summer 2022
+
+#include "thread_pool.h"
+#include <algorithm>
+
+class ThreadPool::Private
+{
+public:
+    // Set on the threads of every ThreadPool's workers
+    static thread_local bool is_worker;
+
+    // Takes a task from worker's own queue or steals one from another, returns
+    // whether a task was found
+    static bool TakeTask(ThreadPool &self, size_t worker, std::function<void(size_t)> &task)
+    {
+        for (size_t k{0}; k < self.queues.size(); k++)
+        {
+            auto &queue{*self.queues[(worker + k) % self.queues.size()]};
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+
+            // Own queue is worked from the front, stolen work comes from the back
+            if (k == 0)
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            else
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    static void Work(ThreadPool &self, size_t worker)
+    {
+        is_worker = true;
+        std::function<void(size_t)> task;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(self.state_mutex);
+                self.task_available.wait(lock, [&self]()
+                                         { return self.queued > 0 || self.stopping; });
+                if (self.queued == 0)
+                {
+                    return;
+                }
+                self.queued--;
+            }
+
+            // A task is reserved for us (queued was decremented) so one will be found
+            while (!Private::TakeTask(self, worker, task))
+            {
+                std::this_thread::yield();
+            }
+
+            try
+            {
+                task(worker);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(self.state_mutex);
+                if (!self.error)
+                {
+                    self.error = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(self.state_mutex);
+            if (--self.pending == 0)
+            {
+                self.all_done.notify_all();
+            }
+        }
+    }
+};
+
+thread_local bool ThreadPool::Private::is_worker{false};
+
+ThreadPool::ThreadPool() : ThreadPool(0) {}
+
+ThreadPool::ThreadPool(size_t n) : pending(0), queued(0), next_queue(0), stopping(false)
+{
+    if (n == 0)
+    {
+        n = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (size_t i{0}; i < n; i++)
+    {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i{0}; i < n; i++)
+    {
+        workers.emplace_back(Private::Work, std::ref(*this), i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        all_done.wait(lock, [this]()
+                      { return pending == 0; });
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+}
+
+size_t ThreadPool::Size() const
+{
+    return workers.size();
+}
+
+bool ThreadPool::IsWorkerThread()
+{
+    return Private::is_worker;
+}
+
+void ThreadPool::Submit(std::function<void(size_t)> task)
+{
+    size_t q;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        q = next_queue;
+        next_queue = (next_queue + 1) % queues.size();
+        pending++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        queues[q]->tasks.push_back(std::move(task));
+    }
+
+    // Only announce the task once it is in a queue
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        queued++;
+    }
+    task_available.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(state_mutex);
+    all_done.wait(lock, [this]()
+                  { return pending == 0; });
+    if (error)
+    {
+        auto e{error};
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+void ThreadPool::ParallelFor(size_t n, const std::function<void(size_t, size_t)> &f)
+{
+    // A few chunks per worker so stealing can balance uneven chunks
+    auto num_chunks{std::min(n, 4 * Size())};
+    for (size_t c{0}; c < num_chunks; c++)
+    {
+        auto begin{n * c / num_chunks};
+        auto end{n * (c + 1) / num_chunks};
+        Submit([&f, begin, end](size_t worker)
+               {
+            for (auto i{begin}; i < end; i++)
+            {
+                f(i, worker);
+            } });
+    }
+    Wait();
+}
@@ -0,0 +1,148 @@
+/*
+Header for ThreadPool.
+
+This file declares the ThreadPool class which runs tasks on a fixed set of
+worker threads that steal work from each other when they run out.
+
+Author: Chami Lamelas
+Date: Summer 2022
+*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <cstddef>
+
+/*
+Work-stealing pool of worker threads.
+
+Each worker has its own queue of tasks. Tasks are spread over the queues
+when submitted, a worker runs tasks from the front of its own queue and,
+once it is empty, steals tasks from the back of the other workers' queues.
+This keeps all workers busy when tasks take very different amounts of time
+(e.g. evaluating a slow ranker next to a fast one).
+
+Every task is given the index (0...Size()-1) of the worker running it so
+it can use per-worker state without locking.
+*/
+class ThreadPool
+{
+public:
+    /*
+    Creates a ThreadPool with one worker per hardware thread.
+    */
+    ThreadPool();
+
+    /*
+    Creates a ThreadPool with a given number of workers.
+
+    Parameters:
+        n: Number of workers, 0 means one per hardware thread.
+    */
+    ThreadPool(size_t n);
+
+    // Waits for the submitted tasks and stops the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Number of workers.
+    size_t Size() const;
+
+    /*
+    Checks if the calling thread is a worker of any ThreadPool.
+
+    Code that can be run both from the main thread and from tasks (e.g. a
+    ranker cloned for each worker of a parallel evaluation) uses this to run
+    serially inside tasks instead of starting more threads than there are
+    cores.
+
+    Returns:
+        true if the calling thread is a worker, false otherwise.
+    */
+    static bool IsWorkerThread();
+
+    /*
+    Submits a task.
+
+    Tasks may submit more tasks, which Wait also waits for.
+
+    Parameters:
+        task: Function taking the index of the worker that runs it.
+    */
+    void Submit(std::function<void(size_t)> task);
+
+    /*
+    Waits until every submitted task has finished.
+
+    Throws:
+        The first exception thrown by a task since the last Wait (the
+        remaining tasks are still run).
+    */
+    void Wait();
+
+    /*
+    Runs a function over a range of indices using the pool and waits for it.
+
+    The range is split into contiguous chunks so consecutive indices tend to
+    run on the same worker. Must not be called from a task running on this
+    pool (it would wait on itself).
+
+    Parameters:
+        n: Number of indices, f is called on 0...n-1.
+        f: Function taking an index and the index of the worker running it.
+
+    Throws:
+        The first exception thrown by f.
+    */
+    void ParallelFor(size_t n, const std::function<void(size_t, size_t)> &f);
+
+private:
+    // Queue of tasks owned by a worker, guarded by its own mutex
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void(size_t)>> tasks;
+    };
+
+    // Inner class that holds private helper functions
+    class Private;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    // Guards the counters below and is used with the condition variables
+    std::mutex state_mutex;
+
+    // Signalled when a task is submitted or the pool is stopping
+    std::condition_variable task_available;
+
+    // Signalled when the last pending task finishes
+    std::condition_variable all_done;
+
+    // Number of submitted tasks that have not finished
+    size_t pending;
+
+    // Number of submitted tasks that have not been taken by a worker
+    size_t queued;
+
+    // Queue the next task is submitted to
+    size_t next_queue;
+
+    // Set by the destructor to stop the workers
+    bool stopping;
+
+    // First exception thrown by a task since the last Wait
+    std::exception_ptr error;
+};
+
+#endif
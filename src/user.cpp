@@ -7,6 +7,7 @@
 #include <iostream>
 #include "solver.h"
 #include "misc.h"
+#include "opening_book.h"
 
 // Removes whitespaces from both ends of a string in place
 void Trim(std::string &s)
@@ -66,7 +67,10 @@ void RunUserMode(std::string_view dictionary_fp, AbstractRanker *ranker)
 
 void RunUserMode(std::string_view dictionary_fp, AbstractRanker *ranker, bool debug_mode)
 {
-    WordleSolver solver(dictionary_fp, ranker, debug_mode);
+    // The session uses its own copy of the ranker so the passed ranker is left untouched
+    auto session_ranker{ranker->Clone()};
+    WordleSolver solver(dictionary_fp, session_ranker.get(), debug_mode);
+    solver.SetOpeningBook(std::make_shared<OpeningBook>(OpeningBook::GetDefaultFilePath(std::string(dictionary_fp))), true);
     std::string guess;
     std::string feedback;
     do
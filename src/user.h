@@ -21,9 +21,17 @@ typed in by the user. The user types in b where they see a black square
 on the Wordle website, y when they see a yellow square, and g when they
 see a green square.
 
+The opening of the ranker is kept in the dictionary's default OpeningBook file
+(see OpeningBook::GetDefaultFilePath), filled lazily (see
+WordleSolver::SetOpeningBook(std::shared_ptr<OpeningBook>,bool)) so the first
+session does not wait on ranking a second guess for every feedback. Later
+sessions look up the first guess and the second guesses seen before rather
+than ranking them.
+
 Parameters:
     dictionary_fp: Dictionary filepath.
-    ranker: Specifies ranking scheme.
+    ranker: Specifies ranking scheme. The session uses a clone of it (see
+    AbstractRanker::Clone) so the passed ranker is not modified.
 */
 void RunUserMode(std::string_view dictionary_fp, AbstractRanker *ranker);
 
@@ -38,7 +46,8 @@ console output.
 
 Parameters:
     dictionary_fp: Dictionary filepath.
-    ranker: Specifies ranking scheme.
+    ranker: Specifies ranking scheme. The session uses a clone of it (see
+    AbstractRanker::Clone) so the passed ranker is not modified.
     debug_mode: Whether underlying WordleSolver should run in debug mode.
 */
 void RunUserMode(std::string_view dictionary_fp, AbstractRanker *ranker, bool debug_mode);
@@ -10,10 +10,10 @@ VowelRanker::VowelRanker(AbstractRanker *r, int cp, unsigned short ng) : VowelRa
 VowelRanker::VowelRanker(std::string_view name, AbstractRanker *r, int cp) : VowelRanker(name, r, cp, 7) {}
 VowelRanker::VowelRanker(std::string_view name, AbstractRanker *r, int cp, unsigned short ng) : AbstractRanker(name), ranker(r), consonant_penalty(cp), num_guesses(ng) {}
 
-void VowelRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void VowelRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
     curr_guess = guess;
-    ranker->SetUp(eligible_fp, guess, feedback);
+    ranker->SetUp(eligible, guess, feedback);
 }
 
 int VowelRanker::Rank(std::string_view word) const
@@ -23,12 +23,40 @@ int VowelRanker::Rank(std::string_view word) const
         return ranker->Rank(word);
     }
 
-    auto consonants{0};
-    for (auto c : word)
+    return ranker->Rank(word) + (consonant_penalty * CountConsonants(EncodeWord(word)));
+}
+
+void VowelRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    ranker->RankAllExact(words, ranks);
+    if (curr_guess > num_guesses)
     {
-        consonants += VOWELS.find(c) == VOWELS.end();
+        return;
     }
-    return ranker->Rank(word) + (consonant_penalty * consonants);
+
+    for (size_t i{0}; i < words.size(); i++)
+    {
+        ranks[i] += consonant_penalty * CountConsonants(words[i].code);
+    }
+}
+
+std::unique_ptr<AbstractRanker> VowelRanker::Clone() const
+{
+    // Copy parameters then replace the shared passed ranker with a clone of it
+    auto clone{std::make_unique<VowelRanker>(*this)};
+    clone->owned_ranker = ranker->Clone();
+    clone->ranker = clone->owned_ranker.get();
+    return clone;
+}
+
+bool VowelRanker::IsDeterministic() const
+{
+    return ranker->IsDeterministic();
+}
+
+uint64_t VowelRanker::GetDataChecksum() const
+{
+    return ranker->GetDataChecksum();
 }
 
 std::string VowelRanker::GetDebugInfo() const
@@ -42,10 +70,10 @@ ProgressVowelRanker::ProgressVowelRanker(AbstractRanker *r, int cp, unsigned sho
 ProgressVowelRanker::ProgressVowelRanker(std::string_view name, AbstractRanker *r, int cp) : ProgressVowelRanker(name, r, cp, 7) {}
 ProgressVowelRanker::ProgressVowelRanker(std::string_view name, AbstractRanker *r, int cp, unsigned short nf) : AbstractRanker(name), ranker(r), consonant_penalty(cp), num_found(nf) {}
 
-void ProgressVowelRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void ProgressVowelRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
     curr_found = feedback.size() - std::count(feedback.cbegin(), feedback.cend(), 'b');;
-    ranker->SetUp(eligible_fp, guess, feedback);
+    ranker->SetUp(eligible, guess, feedback);
 }
 
 int ProgressVowelRanker::Rank(std::string_view word) const
@@ -55,12 +83,40 @@ int ProgressVowelRanker::Rank(std::string_view word) const
         return ranker->Rank(word);
     }
 
-    auto consonants{0};
-    for (auto c : word)
+    return ranker->Rank(word) + (consonant_penalty * CountConsonants(EncodeWord(word)));
+}
+
+void ProgressVowelRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    ranker->RankAllExact(words, ranks);
+    if (curr_found >= num_found)
     {
-        consonants += VOWELS.find(c) == VOWELS.end();
+        return;
     }
-    return ranker->Rank(word) + (consonant_penalty * consonants);
+
+    for (size_t i{0}; i < words.size(); i++)
+    {
+        ranks[i] += consonant_penalty * CountConsonants(words[i].code);
+    }
+}
+
+std::unique_ptr<AbstractRanker> ProgressVowelRanker::Clone() const
+{
+    // Copy parameters then replace the shared passed ranker with a clone of it
+    auto clone{std::make_unique<ProgressVowelRanker>(*this)};
+    clone->owned_ranker = ranker->Clone();
+    clone->ranker = clone->owned_ranker.get();
+    return clone;
+}
+
+bool ProgressVowelRanker::IsDeterministic() const
+{
+    return ranker->IsDeterministic();
+}
+
+uint64_t ProgressVowelRanker::GetDataChecksum() const
+{
+    return ranker->GetDataChecksum();
 }
 
 std::string ProgressVowelRanker::GetDebugInfo() const
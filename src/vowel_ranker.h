@@ -11,11 +11,32 @@ Date: Summer 2022
 #define VOWEL_RANKER_H
 
 #include "ranker.h"
-#include <unordered_set>
+#include <cstdint>
 
-// Set of vowels used by rankers (initialized here because too
-// complicated to initialize static const members that are objects)
-const std::unordered_set<char> VOWELS{'a', 'e', 'i', 'o', 'u'};
+// Letter mask (see LetterMask) of the vowels used by rankers
+constexpr uint32_t VOWEL_MASK{(1u << ('a' - 'a')) | (1u << ('e' - 'a')) | (1u << ('i' - 'a')) | (1u << ('o' - 'a')) | (1u << ('u' - 'a'))};
+
+/*
+Counts the consonants in a word.
+
+Each letter is checked against VOWEL_MASK with a shift, so no set of vowels
+is searched.
+
+Parameters:
+    code: Packed word (see EncodeWord).
+
+Returns:
+    The number of letters (counting repeats) that are not vowels.
+*/
+inline int CountConsonants(uint32_t code)
+{
+    auto consonants{0};
+    for (unsigned short j{0}; j < WORD_LENGTH; j++)
+    {
+        consonants += ((VOWEL_MASK >> CodeLetter(code, j)) & 1) == 0;
+    }
+    return consonants;
+}
 
 /*
 A ranker that penalizes the presences of consonants in another ranker.
@@ -79,12 +100,12 @@ public:
     Sets up this ranker by calling SetUp on the AbstractRanker passed via the constructor.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes a rank using the passed AbstractRanker and potentially a consonant penalty.
@@ -103,6 +124,18 @@ public:
     */
     virtual int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Returns IsDeterministic() as defined by the passed ranker.
+    virtual bool IsDeterministic() const override;
+
+    // Returns GetDataChecksum() as defined by the passed ranker.
+    virtual uint64_t GetDataChecksum() const override;
+
     // Returns GetDebugInfo() as defined by the passed ranker.
     virtual std::string GetDebugInfo() const override;
 
@@ -110,6 +143,9 @@ private:
     // Passed ranker (used to implement SetUp, Rank, GetDebugInfo)
     AbstractRanker *ranker;
 
+    // Owns the passed ranker when this ranker is a clone (ranker points to it)
+    std::shared_ptr<AbstractRanker> owned_ranker;
+
     // Consonant penalty (cp in constructors) applied to each consontant
     int consonant_penalty;
 
@@ -181,12 +217,12 @@ public:
     Sets up this ranker by calling SetUp on the AbstractRanker passed via the constructor.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes a rank using the passed AbstractRanker and potentially a consonant penalty.
@@ -205,6 +241,18 @@ public:
     */
     virtual int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Returns IsDeterministic() as defined by the passed ranker.
+    virtual bool IsDeterministic() const override;
+
+    // Returns GetDataChecksum() as defined by the passed ranker.
+    virtual uint64_t GetDataChecksum() const override;
+
     // Returns GetDebugInfo() as defined by the passed ranker.
     virtual std::string GetDebugInfo() const override;
 
@@ -212,6 +260,9 @@ private:
     // Passed ranker (used to implement SetUp, Rank, GetDebugInfo)
     AbstractRanker *ranker;
 
+    // Owns the passed ranker when this ranker is a clone (ranker points to it)
+    std::shared_ptr<AbstractRanker> owned_ranker;
+
     // Consonant penalty (cp in constructors) applied to each consontant
     int consonant_penalty;
 
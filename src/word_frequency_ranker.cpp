@@ -3,56 +3,68 @@
 // Date: Summer 2022
 
 #include "word_frequency_ranker.h"
-#include <fstream>
 #include "misc.h"
-#include <limits>
 #include <algorithm>
 
 WordFrequencyRanker::WordFrequencyRanker(AbstractRanker *r, const std::string &freq_fp) : WordFrequencyRanker("WordFrequencyRanker(" + r->GetName() + ",\"" + freq_fp + "\")", r, freq_fp) {}
-WordFrequencyRanker::WordFrequencyRanker(std::string_view name, AbstractRanker *r, const std::string &freq_fp) : AbstractRanker(name), ranker(r)
+WordFrequencyRanker::WordFrequencyRanker(std::string_view name, AbstractRanker *r, const std::string &freq_fp) : AbstractRanker(name), ranker(r), ranking(PopularityRanking::Load(freq_fp)), ranks_checksum(0) {}
+
+void WordFrequencyRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
-    std::ifstream words_file(freq_fp, std::ios_base::in);
-    if (!words_file.is_open())
+    auto d{eligible.GetDictionary()};
+    if (d != nullptr && (ranks_by_id == nullptr || ranks_checksum != d->GetChecksum()))
     {
-        throw WordleSolverException("Could not open " + freq_fp + " for reading");
+        ranks_by_id = ranking->GetRanksById(*d);
+        ranks_checksum = d->GetChecksum();
     }
+    ranker->SetUp(eligible, guess, feedback);
+}
+
+int WordFrequencyRanker::Rank(std::string_view word) const
+{
+    return ranker->Rank(word) + ranking->Find(word);
+}
 
-    std::string line;
-    int curr_rank{0};
-    long curr_count{LONG_MAX};
-    while (words_file.good())
+void WordFrequencyRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    ranker->RankAllExact(words, ranks);
+    for (size_t i{0}; i < words.size(); i++)
     {
-        std::getline(words_file, line);
-        auto idx{line.find(',')};
-        long count{std::stol(line.substr(idx + 1))};
-
-        if (count < curr_count)
-        {
-            curr_rank++;
-            curr_count = count;
-        }
-        ranking[line.substr(0, idx)] = curr_rank;
+        ranks[i] += Popularity(words[i]);
     }
+}
 
-    words_file.close();
+int WordFrequencyRanker::Popularity(const Word &word) const
+{
+    return (ranks_by_id != nullptr && word.id != Word::NO_ID) ? (*ranks_by_id)[word.id] : ranking->Find(word.text);
 }
 
-void WordFrequencyRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+std::unique_ptr<AbstractRanker> WordFrequencyRanker::Clone() const
 {
-    ranker->SetUp(eligible_fp, guess, feedback);
+    // Copy parameters (sharing the popularity ranking) then replace the shared
+    // passed ranker with a clone of it
+    auto clone{std::make_unique<WordFrequencyRanker>(*this)};
+    clone->owned_ranker = ranker->Clone();
+    clone->ranker = clone->owned_ranker.get();
+    return clone;
 }
 
-int WordFrequencyRanker::Rank(std::string_view word) const
+bool WordFrequencyRanker::IsDeterministic() const
+{
+    return ranker->IsDeterministic();
+}
+
+uint64_t WordFrequencyRanker::GetDataChecksum() const
 {
-    auto p{ranking.find(std::string(word))};
-    return ranker->Rank(word) + ((p == ranking.end()) ? ranking.size() + 1 : p->second);
+    // FNV-1a step (see Dictionary::GetChecksum) so the order of the checksums matters
+    return (ranker->GetDataChecksum() ^ ranking->GetChecksum()) * 1099511628211ull;
 }
 
 std::string WordFrequencyRanker::GetDebugInfo() const
 {
     std::string debug_info;
-    debug_info.reserve(ranking.size() * 10);
-    for (auto p : ranking)
+    debug_info.reserve(ranking->Size() * 10);
+    for (const auto &p : ranking->GetRanks())
     {
         debug_info += p.first;
         debug_info += ": ";
@@ -68,13 +80,35 @@ ProgressWordFrequencyRanker::ProgressWordFrequencyRanker(AbstractRanker *r, cons
 ProgressWordFrequencyRanker::ProgressWordFrequencyRanker(std::string_view name, AbstractRanker *r, const std::string &freq_fp) : ProgressWordFrequencyRanker(name, r, freq_fp, 6) {}
 ProgressWordFrequencyRanker::ProgressWordFrequencyRanker(std::string_view name, AbstractRanker *r, const std::string &freq_fp, unsigned short nf) : WordFrequencyRanker(name, r, freq_fp), num_found(nf) {}
 
-void ProgressWordFrequencyRanker::SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback)
+void ProgressWordFrequencyRanker::SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback)
 {
     curr_found = feedback.size() - std::count(feedback.cbegin(), feedback.cend(), 'b');
-    WordFrequencyRanker::SetUp(eligible_fp, guess, feedback);
+    WordFrequencyRanker::SetUp(eligible, guess, feedback);
 }
 
 int ProgressWordFrequencyRanker::Rank(std::string_view word) const
 {
     return (curr_found >= num_found) ? WordFrequencyRanker::Rank(word) : ranker->Rank(word);
-}
\ No newline at end of file
+}
+
+void ProgressWordFrequencyRanker::RankAll(std::span<const Word> words, std::span<int> ranks) const
+{
+    if (curr_found >= num_found)
+    {
+        WordFrequencyRanker::RankAll(words, ranks);
+    }
+    else
+    {
+        ranker->RankAllExact(words, ranks);
+    }
+}
+
+std::unique_ptr<AbstractRanker> ProgressWordFrequencyRanker::Clone() const
+{
+    // Copy parameters (sharing the popularity ranking) then replace the shared
+    // passed ranker with a clone of it
+    auto clone{std::make_unique<ProgressWordFrequencyRanker>(*this)};
+    clone->owned_ranker = ranker->Clone();
+    clone->ranker = clone->owned_ranker.get();
+    return clone;
+}
@@ -11,7 +11,10 @@ Date: Summer 2022
 #define WORD_FREQUENCY_RANKER_H
 
 #include "ranker.h"
-#include <unordered_map>
+#include "popularity_ranking.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
 
 /*
 A ranker that incorporates how common a word is in a ranking.
@@ -56,13 +59,17 @@ public:
     /*
     Sets up this ranker by calling SetUp on the AbstractRanker passed via the constructor.
 
+    The popularity ranks of the words of the eligible words' Dictionary are
+    resolved by id (see PopularityRanking::GetRanksById) the first time it is
+    seen, so RankAll looks them up with a single load.
+
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback);
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback);
 
     /*
     Computes a rank using the passed AbstractRanker and the popularity ranking.
@@ -81,6 +88,18 @@ public:
     */
     virtual int Rank(std::string_view word) const;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
+    // Returns IsDeterministic() as defined by the passed ranker.
+    virtual bool IsDeterministic() const override;
+
+    // Returns GetDataChecksum() of the passed ranker combined with the checksum of the frequency file.
+    virtual uint64_t GetDataChecksum() const override;
+
     /*
     Gets debug information on this ranker and the passed ranker.
 
@@ -95,9 +114,32 @@ protected:
     // Passed ranker (used to implement SetUp, Rank, GetDebugInfo)
     AbstractRanker *ranker;
 
+    // Owns the passed ranker when this ranker is a clone (ranker points to it)
+    std::shared_ptr<AbstractRanker> owned_ranker;
+
+    /*
+    Gets the popularity rank of a word.
+
+    Parameters:
+        word: Word to rank (with its id if it is in the Dictionary of the
+              latest SetUp).
+
+    Returns:
+        The popularity rank (see Rank).
+    */
+    int Popularity(const Word &word) const;
+
 private:
-    // Ranking of words by popularity constructed using freq_fp
-    std::unordered_map<std::string, int> ranking;
+    // Ranking of words by popularity loaded from freq_fp, shared with every
+    // other ranker using freq_fp (and with clones)
+    std::shared_ptr<const PopularityRanking> ranking;
+
+    // Popularity ranks of the words of the Dictionary of the latest SetUp by
+    // id (nullptr before a SetUp on words in a Dictionary)
+    std::shared_ptr<const std::vector<int>> ranks_by_id;
+
+    // Checksum of the Dictionary ranks_by_id was resolved for
+    uint64_t ranks_checksum;
 };
 
 /*
@@ -162,12 +204,12 @@ public:
     Sets up this ranker by calling SetUp on the AbstractRanker passed via the constructor.
 
     Parameters:
-        eligible_fp: Path to the remaining eligible words.
+        eligible: The remaining eligible words.
         guess: What guess this set up will be for (1...6).
         feedback: Feedback on previous guess (if guess = 1, this parameter should not
                   be used by SetUp, it will be set to some placeholder when called).
     */
-    virtual void SetUp(const std::string &eligible_fp, unsigned short guess, std::string_view feedback) override;
+    virtual void SetUp(const EligibleWords &eligible, unsigned short guess, std::string_view feedback) override;
 
     /*
     Computes a rank using the passed AbstractRanker and the popularity ranking.
@@ -186,6 +228,12 @@ public:
     */
     virtual int Rank(std::string_view word) const override;
 
+    // Ranks a batch of words (see AbstractRanker::RankAll).
+    virtual void RankAll(std::span<const Word> words, std::span<int> ranks) const override;
+
+    // Returns a deep copy of this ranker (see AbstractRanker::Clone).
+    virtual std::unique_ptr<AbstractRanker> Clone() const override;
+
 private:
     // After we have got this many found, start prioritizing common words
     unsigned short num_found;